@@ -58,6 +58,8 @@ void testIMUDataReporter();
 
 void testMuscleAnalysisSerialization();
 
+void testMultipleThreads();
+
 int main()
 {
     SimTK::Array_<std::string> failures;
@@ -110,6 +112,12 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testMuscleAnalysisSerialization");
     }   
+    try {
+        testMultipleThreads();
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMultipleThreads");
+    }
 
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
@@ -609,4 +617,35 @@ void testMuscleAnalysisSerialization()
     // Check deserialization and copying
     roundTrip = MuscleAnalysis("manalysis.xml");
     ASSERT(!roundTrip.getComputeMoments());
-}
\ No newline at end of file
+}
+
+void testMultipleThreads() {
+    // Recording the analyses on multiple threads gives the same results as
+    // recording them on a single thread.
+    for (int numThreads : {1, 3}) {
+        AnalyzeTool analyze("PlotterTool.xml");
+        analyze.setName("BothLegs_threads" + std::to_string(numThreads));
+        analyze.setNumThreads(numThreads);
+        Model& model = analyze.getModel();
+        BodyKinematics* bodyKinematics = new BodyKinematics(&model);
+        bodyKinematics->setName("BodyKinematics");
+        model.addAnalysis(bodyKinematics);
+        analyze.run();
+    }
+
+    for (const std::string suffix : {"__FiberLength", "_Actuation_force",
+                 "_BodyKinematics_pos_global"}) {
+        Storage serial("testPlotterTool/BothLegs_threads1" + suffix + ".sto");
+        Storage parallel("testPlotterTool/BothLegs_threads3" + suffix + ".sto");
+        ASSERT(serial.getSize() > 3);
+        ASSERT(parallel.getSize() == serial.getSize());
+        for (int i = 0; i < serial.getSize(); ++i) {
+            ASSERT_EQUAL(serial.getStateVector(i)->getTime(),
+                    parallel.getStateVector(i)->getTime(), 1e-12);
+        }
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+                std::vector<double>(serial.getColumnLabels().getSize(), 1e-10),
+                __FILE__, __LINE__, "testMultipleThreads " + suffix + " failed");
+    }
+    cout << "testMultipleThreads passed" << endl;
+}
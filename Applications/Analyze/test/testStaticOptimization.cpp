@@ -40,6 +40,10 @@ void testArm26(const string& muscleModelClassName, double atol, double ftol);
 
 void testArm26DisabledMuscles();
 
+void testArm26Parallel();
+
+void testArm26AnalyticConstraintJacobian();
+
 void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
@@ -105,6 +109,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testArm26Parallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26Parallel");
+    }
+
+    try {
+        testArm26AnalyticConstraintJacobian();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26AnalyticConstraintJacobian");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +285,74 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testArm26Parallel() {
+    // Solving the optimizations in parallel should give the same results as
+    // solving them serially, apart from small differences caused by restarting
+    // the warm start at the beginning of each thread's block of times.
+    AnalyzeTool serial("arm26_Setup_StaticOptimization.xml");
+    serial.setResultsDir("Results_arm26_StaticOptimization_Serial");
+    serial.run();
+
+    AnalyzeTool parallel("arm26_Setup_StaticOptimization.xml");
+    parallel.setResultsDir("Results_arm26_StaticOptimization_Parallel");
+    auto& so = dynamic_cast<StaticOptimization&>(
+            parallel.updAnalysisSet().get("StaticOptimization"));
+    so.setNumThreads(3);
+    parallel.run();
+
+    Storage serialActivations(serial.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    Storage parallelActivations(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(serialActivations.getSize(), parallelActivations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelActivations, serialActivations,
+        std::vector<double>(6, 0.005),
+        __FILE__, __LINE__,
+        "Arm26 parallel activations failed");
+
+    Storage serialForces(serial.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    Storage parallelForces(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    ASSERT_EQUAL(serialForces.getSize(), parallelForces.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelForces, serialForces,
+        std::vector<double>(6, 1),
+        __FILE__, __LINE__,
+        "Arm26 parallel forces failed");
+}
+
+void testArm26AnalyticConstraintJacobian() {
+    // The constraints are linear in the actuator forces, so assembling the
+    // constraint matrix from the moment arms should match the matrix obtained
+    // by perturbing each actuator, up to roundoff.
+    AnalyzeTool perturbed("arm26_Setup_StaticOptimization.xml");
+    perturbed.setResultsDir("Results_arm26_StaticOptimization_Perturbed");
+    perturbed.run();
+
+    AnalyzeTool analytic("arm26_Setup_StaticOptimization.xml");
+    analytic.setResultsDir("Results_arm26_StaticOptimization_Analytic");
+    auto& so = dynamic_cast<StaticOptimization&>(
+            analytic.updAnalysisSet().get("StaticOptimization"));
+    so.setUseAnalyticConstraintJacobian(true);
+    analytic.run();
+
+    Storage perturbedActivations(perturbed.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    Storage analyticActivations(analytic.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(analyticActivations, perturbedActivations,
+        std::vector<double>(6, 1e-4),
+        __FILE__, __LINE__,
+        "Arm26 analytic constraint Jacobian activations failed");
+
+    Storage perturbedForces(perturbed.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    Storage analyticForces(analytic.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(analyticForces, perturbedForces,
+        std::vector<double>(6, 0.1),
+        __FILE__, __LINE__,
+        "Arm26 analytic constraint Jacobian forces failed");
+}
@@ -39,6 +39,7 @@ using namespace std;
 
 void testThoracoscapularShoulderModel();
 void testBallJoint();
+void testMultipleThreads();
 
 int main()
 {
@@ -70,6 +71,9 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        testMultipleThreads();
+        cout << "testMultipleThreads passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
@@ -138,6 +142,39 @@ void testThoracoscapularShoulderModel() {
         "testThoracoscapularShoulderModel failed");
 }
 
+void testMultipleThreads() {
+    // Solving the frames on multiple threads gives the same generalized and
+    // joint forces as solving them on a single thread.
+    Array<std::string> allJoints;
+    allJoints.append("All");
+    for (int numThreads : {1, 4}) {
+        InverseDynamicsTool id("subject01_Setup_InverseDynamics.xml");
+        id.setNumThreads(numThreads);
+        const std::string suffix = "_threads" + std::to_string(numThreads);
+        id.setOutputGenForceFileName("subject01_InverseDynamics" + suffix +
+                                     ".sto");
+        id.updPropertySet().get("joints_to_report_body_forces")
+                ->setValue(allJoints);
+        id.updPropertySet().get("output_body_forces_file")
+                ->setValue("subject01_BodyForces" + suffix + ".sto");
+        id.run();
+    }
+
+    Storage genForces1("Results/subject01_InverseDynamics_threads1.sto");
+    Storage genForces4("Results/subject01_InverseDynamics_threads4.sto");
+    ASSERT(genForces1.getSize() == genForces4.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(genForces4, genForces1,
+            std::vector<double>(genForces1.getColumnLabels().getSize(), 1e-10),
+            __FILE__, __LINE__, "testMultipleThreads generalized forces failed");
+
+    Storage bodyForces1("Results/subject01_BodyForces_threads1.sto");
+    Storage bodyForces4("Results/subject01_BodyForces_threads4.sto");
+    ASSERT(bodyForces1.getSize() == bodyForces4.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(bodyForces4, bodyForces1,
+            std::vector<double>(bodyForces1.getColumnLabels().getSize(), 1e-10),
+            __FILE__, __LINE__, "testMultipleThreads body forces failed");
+}
+
 void testBallJoint() {
     Model mdl;
     Body* bdy = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
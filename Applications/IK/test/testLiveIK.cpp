@@ -31,6 +31,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/StreamingInverseKinematics.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IKTaskSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -41,6 +42,7 @@ using namespace std;
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+void testStreamingInverseKinematics();
 TimeSeriesTable_<SimTK::Rotation> convertMotionFileToRotations(
         Model& model, const std::string& motionFile);
 
@@ -93,6 +95,13 @@ void producer(std::shared_ptr<BufferedOrientationsReference> oRef,
 
 int main() {
 
+    try {
+        testStreamingInverseKinematics();
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        return 1;
+    }
+
     try {
         Model model("subject01_simbody.osim");
 
@@ -343,6 +352,122 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+void testStreamingInverseKinematics() {
+    Model model("subject01_simbody.osim");
+    const auto orientationsData = convertMotionFileToRotations(
+            model, "std_subject01_walk1_ik.mot");
+    const auto& times = orientationsData.getIndependentColumn();
+    const int numFrames = (int)times.size();
+    const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
+
+    // Push the frames while the engine solves them, then collect the results
+    // once the engine is done.
+    auto streamFrames = [&](StreamingInverseKinematics& engine) {
+        engine.start();
+        for (int i = 1; i < numFrames; ++i) {
+            ASSERT(engine.pushFrame(times[i],
+                    orientationsData.getRowAtIndex(i)));
+        }
+        // Frames must be pushed in order.
+        ASSERT(!engine.pushFrame(times[1], orientationsData.getRowAtIndex(1)));
+        ASSERT(engine.getNumRejectedFrames() == 1);
+        engine.stop();
+
+        std::vector<StreamingInverseKinematics::Result> results;
+        StreamingInverseKinematics::Result result;
+        while (engine.tryPopResult(result)) results.push_back(result);
+        ASSERT(engine.getNumDiscardedResults() == 0);
+        ASSERT(!engine.hasFailed());
+        // The assembly in start() is not a pushed frame and has no latency.
+        ASSERT(SimTK::isNaN(results.front().latency));
+        ASSERT(engine.getLatencyHistogram().getNumSamples() ==
+               (int)results.size() - 1);
+        for (int i = 1; i < (int)results.size(); ++i) {
+            ASSERT(results[i].time > results[i - 1].time);
+        }
+        const auto& histogram = engine.getLatencyHistogram();
+        cout << "Streaming IK latency: mean = " << histogram.getMean()
+             << " s, 95th percentile = " << histogram.calcPercentile(0.95)
+             << " s, max = " << histogram.getMax() << " s." << endl;
+        return results;
+    };
+
+    // With an unbounded latency budget, every frame is solved.
+    {
+        StreamingInverseKinematics engine(model, orientationsData, numFrames);
+        engine.setLatencyBudget(SimTK::Infinity);
+        const auto results = streamFrames(engine);
+        ASSERT(engine.getNumSolvedFrames() == numFrames);
+        ASSERT((int)results.size() == numFrames);
+
+        TimeSeriesTable report;
+        report.setColumnLabels(engine.getCoordinateNames());
+        for (const auto& result : results) {
+            ASSERT(!result.interpolated);
+            report.appendRow(
+                    result.time, SimTK::RowVector(~result.coordinateValues));
+        }
+        compareMotionTables(report, standard);
+    }
+
+    // Without a latency budget, the solver skips to the most recent frame
+    // and interpolates the results of the frames it skipped.
+    {
+        StreamingInverseKinematics engine(model, orientationsData, numFrames);
+        engine.setLatencyBudget(0);
+        const auto results = streamFrames(engine);
+        ASSERT((int)results.size() == numFrames);
+        ASSERT(engine.getNumSolvedFrames() +
+                       engine.getNumInterpolatedFrames() == numFrames);
+        for (int i = 0; i < numFrames; ++i) {
+            ASSERT_EQUAL(times[i], results[i].time, 0.0);
+        }
+        // The frames are pushed much faster than they are solved.
+        ASSERT(engine.getNumInterpolatedFrames() > 0);
+        ASSERT(!results.front().interpolated);
+        ASSERT(!results.back().interpolated);
+
+        // Each interpolated result lies on the line between the results of
+        // the solved frames before and after it.
+        int numInterpolated = 0;
+        int previous = 0;
+        for (int i = 1; i < numFrames; ++i) {
+            if (results[i].interpolated) continue;
+            for (int j = previous + 1; j < i; ++j) {
+                ASSERT(results[j].interpolated);
+                const double weight = (times[j] - times[previous]) /
+                                      (times[i] - times[previous]);
+                const SimTK::Vector& before =
+                        results[previous].coordinateValues;
+                const SimTK::Vector& after = results[i].coordinateValues;
+                for (int k = 0; k < before.size(); ++k) {
+                    ASSERT_EQUAL(before[k] + weight * (after[k] - before[k]),
+                            results[j].coordinateValues[k],
+                            1e-12 * (1 + std::abs(before[k])));
+                }
+                ++numInterpolated;
+            }
+            previous = i;
+        }
+        ASSERT(numInterpolated == engine.getNumInterpolatedFrames());
+    }
+
+    // The results of skipped frames can also be dropped.
+    {
+        StreamingInverseKinematics engine(model, orientationsData, numFrames);
+        engine.setLatencyBudget(0);
+        engine.setLateFramePolicy(
+                StreamingInverseKinematics::LateFramePolicy::Drop);
+        const auto results = streamFrames(engine);
+        ASSERT(engine.getNumInterpolatedFrames() == 0);
+        ASSERT((int)results.size() == engine.getNumSolvedFrames());
+        ASSERT(engine.getNumSolvedFrames() + engine.getNumDroppedFrames() ==
+               numFrames);
+        ASSERT_EQUAL(times.back(), results.back().time, 0.0);
+    }
+}
+
 void producer(std::shared_ptr<BufferedOrientationsReference> oRef,
         TimeSeriesTable_<SimTK::Rotation>& dataSource) {
     auto times = dataSource.getIndependentColumn();
@@ -32,12 +32,13 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool [--num-threads=<n>] <setup-xml-file>
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  -j <n>, --num-threads <n>  Number of threads for Analyze or Inverse Dynamics.
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -56,8 +57,13 @@ Description:
 
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
+  The --num-threads option overrides the num_threads property of Analyze and
+  Inverse Dynamics setup files; a value less than 1 means to use the number
+  of hardware threads. It is ignored for other tools.
+
 Examples:
   opensim-cmd run-tool CMC_setup.xml
+  opensim-cmd run-tool --num-threads 4 Analyze_setup.xml
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
@@ -71,6 +77,20 @@ int run_tool(int argc, const char** argv) {
             HELP_RUN_TOOL, { argv + 1, argv + argc },
             true); // show help if requested
 
+    // Number of threads.
+    bool hasNumThreads = false;
+    int numThreads = 1;
+    if (args["--num-threads"]) {
+        const auto& value = args["--num-threads"].asString();
+        try {
+            numThreads = std::stoi(value);
+        } catch (const std::exception&) {
+            throw Exception("Expected an integer number of threads, but got '" +
+                    value + "'.");
+        }
+        hasNumThreads = true;
+    }
+
     // Deserialize.
     const auto& setupFile = args["<setup-xml-file>"].asString();
     auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
@@ -94,19 +114,33 @@ int run_tool(int argc, const char** argv) {
         } else if (dynamic_cast<ForwardTool*>(tool)) {
             concreteTool.reset(new ForwardTool(setupFile));
         } else if (dynamic_cast<AnalyzeTool*>(tool)) {
-            concreteTool.reset(new AnalyzeTool(setupFile));
+            auto* analyze = new AnalyzeTool(setupFile);
+            if (hasNumThreads) analyze->setNumThreads(numThreads);
+            concreteTool.reset(analyze);
         } else {
             log_warn("Detected an AbstractTool that is not RRA, "
                      "CMC, Forward, or Analyze; custom tools may not get "
                      "constructed properly.");
             concreteTool.reset(tool->clone());
         }
+        if (hasNumThreads && !dynamic_cast<AnalyzeTool*>(concreteTool.get())) {
+            log_warn("Ignoring --num-threads for {}.",
+                    tool->getConcreteClassName());
+        }
         const bool success = concreteTool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
     } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
+        if (hasNumThreads) {
+            if (auto* id = dynamic_cast<InverseDynamicsTool*>(tool)) {
+                id->setNumThreads(numThreads);
+            } else {
+                log_warn("Ignoring --num-threads for {}.",
+                        tool->getConcreteClassName());
+            }
+        }
         const bool success = tool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
@@ -326,6 +326,10 @@ void testRunTool() {
     // This fails because this setup file doesn't have much in it.
     testCommand("run-tool testruntool_cmc_setup.xml", EXIT_FAILURE,
             std::regex(RE_ANY + "(No model file was specified)" + RE_ANY));
+    testCommand("run-tool --num-threads two testruntool_cmc_setup.xml",
+            EXIT_FAILURE,
+            ContainsSubstring("Expected an integer number of threads, but "
+                              "got 'two'."));
     // Similar to the previous two commands, except for scaling
     // (since ScaleTool goes through a different branch of the code).
     testCommand("print-xml scale testruntool_scale_setup.xml", EXIT_SUCCESS,
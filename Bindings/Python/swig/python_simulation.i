@@ -103,11 +103,6 @@ MODEL_ADOPT_HELPER(Controller);
 // Pythonic operators
 // ==================
 // Allow iterating through a StatesTrajectory.
-// This extend block must appear before the %template call in simulation.i.
-
-// TODO remove.
-%rename(_getBetween) OpenSim::StatesTrajectory::getBetween;
-
 %extend OpenSim::StatesTrajectory {
 %pythoncode %{
 
@@ -118,15 +113,8 @@ MODEL_ADOPT_HELPER(Controller);
             for state in states:
                 model.calcMassCenterPosition(state)
         """
-        it = self.begin()
-        while it != self.end():
-            yield it.next()
-
-    def getBetween(self, *args, **kwargs):
-        iter_range = self._getBetween(*args, **kwargs)
-        it = iter_range.begin()
-        while it != iter_range.end():
-            yield it.next()
+        for i in range(self.getSize()):
+            yield self.get(i)
 %}
 };
 
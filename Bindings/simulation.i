@@ -120,8 +120,10 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %include <OpenSim/Simulation/Model/ContactMesh.h>
 %include <OpenSim/Simulation/Model/ContactSphere.h>
 %include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
+%include <OpenSim/Simulation/Model/MeshElasticFoundationForce.h>
 %include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
 %include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
+%include <OpenSim/Simulation/Model/MultiSmoothSphereHalfSpaceForce.h>
 
 %include <OpenSim/Simulation/Model/Actuator.h>
 %template(SetActuators) OpenSim::Set<OpenSim::Actuator, OpenSim::Object>;
@@ -213,6 +215,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %template(ReferenceDouble) OpenSim::Reference_<double>;
 %template(ReferenceRotation) OpenSim::Reference_<SimTK::Rotation_<double>>;
 %template(StreamableReferenceRotation) OpenSim::StreamableReference_<SimTK::Rotation_<double>>;
+%template(StreamableReferenceVec3) OpenSim::StreamableReference_<SimTK::Vec3>;
 
 %template(SimTKArrayCoordinateReference) SimTK::Array_<OpenSim::CoordinateReference>;
 
@@ -235,8 +238,13 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 //
 %template (SetOientationWeights) OpenSim::Set<OrientationWeight, OpenSim::Object>;
 %template(SharedOrientationsReference) std::shared_ptr<OpenSim::OrientationsReference>;
+%include <OpenSim/Simulation/BufferedReference.h>
+%template(BufferedReferenceOrientations) OpenSim::BufferedReference_<OpenSim::OrientationsReference>;
+%template(BufferedReferenceMarkers) OpenSim::BufferedReference_<OpenSim::MarkersReference>;
 %include <OpenSim/Simulation/BufferedOrientationsReference.h>
 %shared_ptr(OpenSim::BufferedOrientationsReference);
+%include <OpenSim/Simulation/BufferedMarkersReference.h>
+%shared_ptr(OpenSim::BufferedMarkersReference);
 
 %include <OpenSim/Simulation/AssemblySolver.h>
 %include <OpenSim/Simulation/InverseKinematicsSolver.h>
@@ -248,9 +256,6 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %template(StdVectorIMUs) std::vector< OpenSim::IMU* >;
 
 %include <OpenSim/Simulation/StatesTrajectory.h>
-// This enables iterating using the getBetween() method.
-%template(IteratorRangeStatesTrajectoryIterator)
-    SimTK::IteratorRange<OpenSim::StatesTrajectory::const_iterator>;
 %include <OpenSim/Simulation/StatesTrajectoryReporter.h>
 %include <OpenSim/Simulation/PositionMotion.h>
 %include <OpenSim/Simulation/SimulationUtilities.h>
@@ -565,26 +565,26 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
         switch(result.first) {
 
         case StatusFromEstimateMuscleFiberState::Success_Converged:
-            setActuation(s, result.second["tendon_force"]);
-            setFiberLength(s, result.second["fiber_length"]);
+            setActuation(s, result.second.tendonForce);
+            setFiberLength(s, result.second.fiberLength);
             break;
 
         case StatusFromEstimateMuscleFiberState::Warning_FiberAtLowerBound:
             log_warn("Millard2012EquilibriumMuscle static solution: '{}' is "
                    "at its minimum fiber length of {}.",
-                   getName(), result.second["fiber_length"]);
-            setActuation(s, result.second["tendon_force"]);
-            setFiberLength(s, result.second["fiber_length"]);
+                   getName(), result.second.fiberLength);
+            setActuation(s, result.second.tendonForce);
+            setFiberLength(s, result.second.fiberLength);
             break;
 
         case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
             // Report internal variables and throw exception.
             std::ostringstream ss;
-            ss << "\n  Solution error " << abs(result.second["solution_error"])
+            ss << "\n  Solution error " << abs(result.second.solutionError)
                << " exceeds tolerance of " << tol << "\n"
                << "  Newton iterations reached limit of " << maxIter << "\n"
                << "  Activation is " << activation << "\n"
-               << "  Fiber length is " << result.second["fiber_length"] << "\n";
+               << "  Fiber length is " << result.second.fiberLength << "\n";
             OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
             break;
         }
@@ -1137,17 +1137,18 @@ calcDampedNormFiberVelocity(double fiso,
     SimTK::Vec4 fiberForceV;
     SimTK::Vec3 result;
 
-    int maxIter = 20; //this routine converges quickly; 20 is quite generous
+    // Newton's method converges in a few iterations from the guess below; the
+    // remaining iterations allow the bisection steps below to converge from
+    // any bracket.
+    int maxIter = 60;
     double tol = 1.0e-10*fiso;
     if(tol < SimTK::SignificantReal*100) {
         tol = SimTK::SignificantReal*100;
     }
-    double perturbation   = 0.0;
     double fiberForce     = 0.0;
     double err            = 1.0e10;
     double derr_d_dlceNdt = 0.0;
-    double delta          = 0.0;
-    double iter           = 0.0;
+    int iter              = 0;
 
     // Get a really excellent starting position to reduce the number of
     // iterations. This reduces the simulation time by about 1%.
@@ -1162,29 +1163,45 @@ calcDampedNormFiberVelocity(double fiso,
         dlceN_dt = -1.0;
     }
 
-    double df_d_dlceNdt = 0.0;
+    // The error increases monotonically with dlceN_dt (the force-velocity
+    // curve is increasing and beta > 0), so the solution lies between the
+    // largest velocity with a negative error and the smallest velocity with a
+    // positive error found so far.
+    double lower = -SimTK::Infinity;
+    double upper = SimTK::Infinity;
 
-    while(abs(err) > tol && iter < maxIter) {
+    while(iter < maxIter) {
         fv = get_ForceVelocityCurve().calcValue(dlceN_dt);
         fiberForceV = calcFiberForce(fiso,a,fal,fv,fpe,dlceN_dt);
         fiberForce = fiberForceV[0];
 
         err = fiberForce*cosPhi - fse*fiso;
-        df_d_dlceNdt = calc_DFiberForce_DNormFiberVelocity(fiso,a,fal,
-                                                           beta,dlceN_dt);
-        derr_d_dlceNdt = df_d_dlceNdt*cosPhi;
-
-        if(abs(err) > tol && abs(derr_d_dlceNdt) > SimTK::SignificantReal) {
-            delta = -err/derr_d_dlceNdt;
-            dlceN_dt = dlceN_dt + delta;
-
-        } else if(abs(derr_d_dlceNdt) < SimTK::SignificantReal) {
-            // Perturb the solution if we've lost rank. This should never happen
-            // for this problem since dfv_d_dlceNdt > 0 and b > 0 (and so
-            // derr_d_dlceNdt > 0).
-            perturbation = 2.0*((double)rand())/((double)RAND_MAX)-1.0;
-            dlceN_dt = dlceN_dt + perturbation*0.05;
+        if(abs(err) <= tol) {
+            break;
+        }
+        if(err < 0) {
+            lower = dlceN_dt;
+        } else {
+            upper = dlceN_dt;
+        }
+
+        derr_d_dlceNdt = calc_DFiberForce_DNormFiberVelocity(fiso,a,fal,
+                                                             beta,dlceN_dt)
+                         *cosPhi;
+        double next = SimTK::NaN;
+        if(abs(derr_d_dlceNdt) > SimTK::SignificantReal) {
+            next = dlceN_dt - err/derr_d_dlceNdt;
+        }
+        // Fall back to bisection if the Newton step leaves the bracket.
+        if(!(next > lower && next < upper)) {
+            if(SimTK::isFinite(lower) && SimTK::isFinite(upper)) {
+                next = 0.5*(lower + upper);
+            } else {
+                // Expand the bracket towards the solution.
+                next = dlceN_dt + (err < 0 ? 0.5 : -0.5);
+            }
         }
+        dlceN_dt = next;
         iter++;
     }
 
@@ -1610,11 +1627,11 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
             lce = getMinimumFiberLength();
         }
 
-        resultValues["solution_error"] = ferr;
-        resultValues["iterations"]     = (double)iter;
-        resultValues["fiber_length"]   = lce;
-        resultValues["fiber_velocity"] = dlce;
-        resultValues["tendon_force"]   = fse*fiso;
+        resultValues.solutionError = ferr;
+        resultValues.iterations    = iter;
+        resultValues.fiberLength   = lce;
+        resultValues.fiberVelocity = dlce;
+        resultValues.tendonForce   = fse*fiso;
 
         return std::pair<StatusFromEstimateMuscleFiberState,
                          ValuesFromEstimateMuscleFiberState>
@@ -1632,11 +1649,11 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
         tlN    = tl/tsl;
         fse    = fseCurve.calcValue(tlN);
 
-        resultValues["solution_error"] = ferr;
-        resultValues["iterations"]     = (double)iter;
-        resultValues["fiber_length"]   = lce;
-        resultValues["fiber_velocity"] = 0;
-        resultValues["tendon_force"]   = fse*fiso;
+        resultValues.solutionError = ferr;
+        resultValues.iterations    = iter;
+        resultValues.fiberLength   = lce;
+        resultValues.fiberVelocity = 0;
+        resultValues.tendonForce   = fse*fiso;
 
         return std::pair<StatusFromEstimateMuscleFiberState,
                          ValuesFromEstimateMuscleFiberState>
@@ -1644,11 +1661,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
              resultValues);
     }
 
-    resultValues["solution_error"] = ferr;
-    resultValues["iterations"]     = (double)iter;
-    resultValues["fiber_length"]   = SimTK::NaN;
-    resultValues["fiber_velocity"] = SimTK::NaN;
-    resultValues["tendon_force"]   = SimTK::NaN;
+    resultValues.solutionError = ferr;
+    resultValues.iterations    = iter;
 
     return std::pair<StatusFromEstimateMuscleFiberState,
                         ValuesFromEstimateMuscleFiberState>
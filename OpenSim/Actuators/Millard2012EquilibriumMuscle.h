@@ -570,7 +570,9 @@ private:
     void extendFinalizeFromProperties() override;
 
     /* Calculates the fiber velocity that satisfies the equilibrium equation
-    given a fixed fiber length.
+    given a fixed fiber length. The equilibrium error increases monotonically
+    with fiber velocity, so Newton steps are safeguarded by a bracket of the
+    solution and replaced by bisection if they leave it.
         @param fiso maximum isometric force
         @param a activation
         @param fal active-force-length multiplier
@@ -741,10 +743,14 @@ private:
         Failure_MaxIterationsReached
     };
 
-    // Associative array of values returned by estimateMuscleFiberState():
-    // solution_error, iterations, fiber_length, fiber_velocity, and
-    // tendon_force.
-    typedef std::map<std::string, double> ValuesFromEstimateMuscleFiberState;
+    // Values returned by estimateMuscleFiberState().
+    struct ValuesFromEstimateMuscleFiberState {
+        double solutionError = SimTK::NaN;
+        int iterations = 0;
+        double fiberLength = SimTK::NaN;
+        double fiberVelocity = SimTK::NaN;
+        double tendonForce = SimTK::NaN;
+    };
 
     /* Solves fiber length and velocity to satisfy the equilibrium equations.
     The velocity of the entire musculotendon actuator is shared between the
@@ -901,6 +901,54 @@ void testMillard2012EquilibriumMuscle()
         muscle->computeInitialFiberEquilibrium(state);
     }
 
+    // The fiber velocity satisfies equilibrium after large changes of the
+    // state, and does not depend on the states evaluated before.
+    {
+        Model model;
+        auto body = new Body("body", 1., SimTK::Vec3(0), SimTK::Inertia(0));
+        model.addBody(body);
+        auto joint = new SliderJoint("joint", model.getGround(), *body);
+        model.addJoint(joint);
+        auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle1);
+        muscle->setFiberDamping(0.1);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", *body, SimTK::Vec3(0));
+        model.addForce(muscle);
+
+        // The fiber along the tendon has its optimal length and the tendon is
+        // stretched by 1%.
+        const double width = OptimalFiberLength0*sin(PennationAngle1);
+        const double fiberLength = sqrt(
+                SimTK::square(OptimalFiberLength0) + SimTK::square(width));
+        SimTK::State& state = model.initSystem();
+        const Coordinate& coord = joint->getCoordinate();
+        coord.setValue(state, OptimalFiberLength0 + 1.01*TendonSlackLength0,
+                false);
+        muscle->setFiberLength(state, fiberLength);
+        coord.setSpeedValue(state, 0.05);
+        muscle->setActivation(state, 0.5);
+        model.realizeDynamics(state);
+        const double fiberVelocity = muscle->getFiberVelocity(state);
+        for (double speed : {0.0, 0.05, -0.3, 0.6, -0.02}) {
+            for (double activation : {0.05, 0.5, 1.0}) {
+                coord.setSpeedValue(state, speed);
+                muscle->setActivation(state, activation);
+                model.realizeDynamics(state);
+                ASSERT_EQUAL(muscle->getTendonForce(state),
+                        muscle->getFiberForceAlongTendon(state),
+                        1e-7*MaxIsometricForce0, __FILE__, __LINE__,
+                        "Fiber velocity does not satisfy equilibrium.");
+            }
+        }
+        coord.setSpeedValue(state, 0.05);
+        muscle->setActivation(state, 0.5);
+        model.realizeDynamics(state);
+        ASSERT(muscle->getFiberVelocity(state) == fiberVelocity, __FILE__,
+                __LINE__, "Fiber velocity depends on the previous states.");
+    }
+
     // Test exception handling when invalid properties are propagated to
     // MuscleFixedWidthPennationModel and MuscleFirstOrderActivationDynamicModel
     // subcomponents.
@@ -263,6 +263,12 @@ allocateStorage()
     _pStore = new Storage(1000,"Positions");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+
+    // Keep references to all storages in a list for uniform access
+    _storageList.setSize(0);
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
 }
 
 
@@ -401,8 +401,7 @@ int InverseDynamics::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
-    SimTK::Matrix massMatrix;
-    _model->getMatterSubsystem().calcM(s, massMatrix);
+    const SimTK::Matrix& massMatrix = _model->updAnalysisCache().getMassMatrix(s);
 
     //massMatrix.dump("mass matrix is:");
     // Check that m is full rank
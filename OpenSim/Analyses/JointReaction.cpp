@@ -487,6 +487,9 @@ setupStorage()
     _storeReactionLoads.setName("Joint Reaction Loads");
     _storeReactionLoads.setDescription(getDescription());
     _storeReactionLoads.setColumnLabels(getColumnLabels());
+    // Keep a reference to the storage in a list for uniform access
+    _storageList.setSize(0);
+    _storageList.append(&_storeReactionLoads);
 
     // Actuator forces - if a forces file is specified, load the forces storage data to _storeActuation
     if(!(_forcesFileName == "")) loadForcesFromFile();
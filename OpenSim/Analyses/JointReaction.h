@@ -190,6 +190,7 @@ public:
         step( const SimTK::State& s, int setNumber ) override;
     int
         end( const SimTK::State& s ) override;
+    bool getCanRecordInParallel() const override { return true; }
 
 
     //-------------------------------------------------------------------------
@@ -644,6 +644,9 @@ int MuscleAnalysis::record(const SimTK::State& s)
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
+        // Moment arms are computed together, once per state, and are shared
+        // with the other analyses of the model.
+        AnalysisCache& cache = _model->updAnalysisCache();
 
         for(int i=0; i<nq; i++) {
 
@@ -656,7 +659,8 @@ int MuscleAnalysis::record(const SimTK::State& s)
             _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = cache.getMomentArm(s,
+                        _muscleArray[j]->getGeometryPath(), *q);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -702,14 +706,21 @@ int MuscleAnalysis::begin(const SimTK::State&s )
     // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
         Coordinate *q = NULL;
         int nq = _momentArmStorageArray.getSize();
+        std::vector<const Coordinate*> coordinates;
         for(int i=0; i<nq; i++) {
             q = _momentArmStorageArray[i]->q;
+            coordinates.push_back(q);
             if (q->getLocked(s)) {
                 log_warn("MuscleAnalysis: coordinate {} is locked and can't be "
                          "varied.",
                         q->getName());
             }
         }
+        std::vector<const GeometryPath*> paths;
+        for(int j=0; j<_muscleArray.getSize(); j++) {
+            paths.push_back(&_muscleArray[j]->getGeometryPath());
+        }
+        _model->updAnalysisCache().requestMomentArms(paths, coordinates);
     }
     if(_storageList.getSize()> 0 && _storageList.get(0)->getSize() <= 0) status = record(s);
 
@@ -274,6 +274,12 @@ allocateStorage()
     _pStore = new Storage(1000,"PointPosition");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+
+    // Keep references to all storages in a list for uniform access
+    _storageList.setSize(0);
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
 }
 
 
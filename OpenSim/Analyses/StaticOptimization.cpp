@@ -25,6 +25,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -32,6 +33,10 @@
 #include "StaticOptimization.h"
 #include "StaticOptimizationTarget.h"
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
 
 
 using namespace OpenSim;
@@ -61,6 +66,8 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _useAnalyticConstraintJacobian(_useAnalyticConstraintJacobianProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +89,8 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _useAnalyticConstraintJacobian(_useAnalyticConstraintJacobianProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +123,8 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _numThreads=aStaticOptimization._numThreads;
+    _useAnalyticConstraintJacobian=aStaticOptimization._useAnalyticConstraintJacobian;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,6 +149,8 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _numThreads = 1;
+    _useAnalyticConstraintJacobian = false;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +186,21 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _numThreadsProp.setComment(
+        "Number of threads used to solve the optimizations at each time. "
+        "With 1 (default), the optimizations are solved serially. Values less "
+        "than 1 use all available hardware threads.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append(&_numThreadsProp);
+
+    _useAnalyticConstraintJacobianProp.setComment(
+        "If true, the acceleration constraint matrix is computed from the "
+        "actuators' moment arms and the mass matrix instead of realizing the "
+        "model to Acceleration once per actuator. Only used if the model has "
+        "no kinematic constraints in use.");
+    _useAnalyticConstraintJacobianProp.setName("use_analytic_constraint_jacobian");
+    _propertySet.append(&_useAnalyticConstraintJacobianProp);
 }
 
 //=============================================================================
@@ -307,44 +335,57 @@ record(const SimTK::State& s)
 {
     if(!_modelWorkingCopy) return -1;
 
+    return solveAtTime(*_modelWorkingCopy, *_forceSet, *_forceReporter,
+            *_activationStorage, _parameters, s.getTime(), s.getQ(), s.getU());
+}
+
+//_____________________________________________________________________________
+/**
+ * Solve the static optimization problem at a given time using the provided
+ * working copy of the model, and append the results to the provided storages.
+ * The muscle activations found are stored as the model's default activations
+ * to warm-start the next call.
+ */
+int StaticOptimization::
+solveAtTime(Model& model, ForceSet& forceSet, ForceReporter& forceReporter,
+        Storage& activationStorage, SimTK::Vector& parameters, double time,
+        const SimTK::Vector& q, const SimTK::Vector& u) const
+{
     // Set model to whatever defaults have been updated to from the last iteration
-    SimTK::State& sWorkingCopy = _modelWorkingCopy->updWorkingState();
-    sWorkingCopy.setTime(s.getTime());
-    _modelWorkingCopy->initStateWithoutRecreatingSystem(sWorkingCopy); 
+    SimTK::State& sWorkingCopy = model.updWorkingState();
+    sWorkingCopy.setTime(time);
+    model.initStateWithoutRecreatingSystem(sWorkingCopy); 
 
     // update Q's and U's
-    sWorkingCopy.setQ(s.getQ());
-    sWorkingCopy.setU(s.getU());
+    sWorkingCopy.setQ(q);
+    sWorkingCopy.setU(u);
 
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
 
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& fs = model.getActuators();
 
     int na = fs.getSize();
     int nacc = _accelerationIndices.getSize();
 
-    // IPOPT
-    _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
-    _printLevel = 0;
-    //_optimizationConvergenceTolerance = 1e-004;
-    //_maxIterations = 2000;
-
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    model.setAllControllersEnabled(false);
+    StaticOptimizationTarget target(sWorkingCopy,&model,na,nacc,_useMusclePhysiology);
     target.setStatesStore(_statesStore);
     target.setStatesSplineSet(_statesSplineSet);
     target.setActivationExponent(_activationExponent);
+    target.setUseAnalyticConstraintJacobian(_useAnalyticConstraintJacobian);
     target.setDX(_numericalDerivativeStepSize);
 
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
-    // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
+    // Optimizer. Each call creates its own optimizer, and with it its own
+    // IPOPT application and linear solver, so that calls on different threads
+    // (see recordDeferred()) share no solver state.
+    std::unique_ptr<SimTK::Optimizer> optimizer(
+            new SimTK::Optimizer(target, algorithm));
 
     // Optimizer options
     //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
@@ -376,11 +417,11 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    parameters = 0; // Set initial guess to zeros
 
     // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
 
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
@@ -391,24 +432,24 @@ record(const SimTK::State& s)
 
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        optimizer->optimize(parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
         log_warn(ex.getMessage());
         log_warn("OPTIMIZATION FAILED...");
         log_warn("StaticOptimization.record: The optimizer could not find a "
                  "solution at time = {}.",
-                s.getTime());
+                time);
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            Actuator* act = dynamic_cast<Actuator*>(&forceSet.get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                Muscle*  mus = dynamic_cast<Muscle*>(&forceSet.get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -417,7 +458,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -428,7 +469,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -448,9 +489,9 @@ record(const SimTK::State& s)
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -465,7 +506,7 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
+            forceReporter.step(sWorkingCopy, 1);
             if(incompleteModel) log_warn(msgIncomplete);
         }
     }
@@ -475,25 +516,145 @@ record(const SimTK::State& s)
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
     if (Logger::shouldLog(Logger::Level::Info)) {
-        target.printPerformance(sWorkingCopy, &_parameters[0]);
+        target.printPerformance(sWorkingCopy, &parameters[0]);
     }
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& actuators = model.getActuators();
     for(int k=0; k < actuators.getSize(); ++k){
         ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
+    activationStorage.append(sWorkingCopy.getTime(),na,&parameters[0]);
 
     SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
+    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), parameters,forces);
+
+    forceReporter.step(sWorkingCopy, 1);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Store the time, generalized coordinates, and generalized speeds of a state
+ * so that its optimization can be solved later by recordDeferred().
+ */
+void StaticOptimization::
+deferRecord(const SimTK::State& s)
+{
+    _deferredTimes.push_back(s.getTime());
+    _deferredQs.push_back(s.getQ());
+    _deferredUs.push_back(s.getU());
+}
+//_____________________________________________________________________________
+/**
+ * Solve the deferred optimizations in parallel. The deferred times are split
+ * into contiguous blocks, one per thread, and each thread solves its block in
+ * time order using its own copy of the working model (so that warm-starting
+ * works within a block). The results are then appended, in time order, to the
+ * activation and force storages.
+ *
+ * Every block starts from the same muscle activations and _parameters, those
+ * of the working model when the deferral began, not from the solution at the
+ * end of the previous block. Results at the first times of each block can
+ * therefore differ slightly from the serial results.
+ *
+ * @return -1 on error, 0 otherwise.
+ */
+int StaticOptimization::
+recordDeferred()
+{
+    if(!_modelWorkingCopy) return -1;
+
+    const int numTimes = (int)_deferredTimes.size();
+    if(numTimes == 0) return 0;
+
+    const int numThreads = getNumThreadsToUse(_numThreads, numTimes);
+
+    struct Worker {
+        std::unique_ptr<Model> model;
+        std::unique_ptr<ForceReporter> forceReporter;
+        std::unique_ptr<Storage> activationStorage;
+        SimTK::Vector parameters;
+        int begin;
+        int end;
+        std::exception_ptr error;
+    };
+    std::vector<Worker> workers(numThreads);
+
+    // Creating the working copies is done serially; only the optimizations
+    // are solved in parallel.
+    for(int ithread = 0; ithread < numThreads; ++ithread) {
+        Worker& worker = workers[ithread];
+        worker.begin = (int)((long long)ithread * numTimes / numThreads);
+        worker.end = (int)((long long)(ithread + 1) * numTimes / numThreads);
+
+        // The working copy already holds the forces selected in begin().
+        worker.model.reset(_modelWorkingCopy->clone());
+        SimTK::State& sWorker = worker.model->initSystem();
+        ForceSet& forceSet = worker.model->updForceSet();
+        for(int i=0; i<forceSet.getSize(); i++) {
+            ScalarActuator* act = dynamic_cast<ScalarActuator*>(&forceSet.get(i));
+            if( act ) {
+                act->overrideActuation(sWorker, true);
+            }
+        }
+        sWorker.setTime(_deferredTimes[worker.begin]);
+        sWorker.setQ(_deferredQs[worker.begin]);
+        sWorker.setU(_deferredUs[worker.begin]);
+        worker.model->getMultibodySystem().realize(sWorker,SimTK::Stage::Velocity);
+
+        worker.forceReporter.reset(new ForceReporter(worker.model.get()));
+        worker.forceReporter->begin(sWorker);
+        worker.forceReporter->updForceStorage().reset();
+
+        worker.activationStorage.reset(
+                new Storage(1000,"Static Optimization"));
+        worker.parameters = _parameters;
+    }
+
+    std::vector<std::thread> threads;
+    for(int ithread = 0; ithread < numThreads; ++ithread) {
+        threads.emplace_back([this, &workers, ithread]() {
+            Worker& worker = workers[ithread];
+            try {
+                for(int itime = worker.begin; itime < worker.end; ++itime) {
+                    solveAtTime(*worker.model, worker.model->updForceSet(),
+                            *worker.forceReporter, *worker.activationStorage,
+                            worker.parameters, _deferredTimes[itime],
+                            _deferredQs[itime], _deferredUs[itime]);
+                }
+            } catch (...) {
+                worker.error = std::current_exception();
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    for(const auto& worker : workers) {
+        if(worker.error) std::rethrow_exception(worker.error);
+    }
+
+    // MERGE RESULTS
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(const auto& worker : workers) {
+        for(int i=0; i<worker.activationStorage->getSize(); i++) {
+            _activationStorage->append(
+                    *worker.activationStorage->getStateVector(i));
+        }
+        const Storage& workerForces = worker.forceReporter->getForceStorage();
+        for(int i=0; i<workerForces.getSize(); i++) {
+            forceStorage.append(*workerForces.getStateVector(i));
+        }
+    }
+    _parameters = workers.back().parameters;
 
-    _forceReporter->step(sWorkingCopy, 1);
+    _deferredTimes.clear();
+    _deferredQs.clear();
+    _deferredUs.clear();
 
     return 0;
 }
@@ -512,6 +673,17 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    // IPOPT
+    _numericalDerivativeStepSize = 0.0001;
+    _optimizerAlgorithm = "ipopt";
+    _printLevel = 0;
+    //_optimizationConvergenceTolerance = 1e-004;
+    //_maxIterations = 2000;
+
+    _deferredTimes.clear();
+    _deferredQs.clear();
+    _deferredUs.clear();
+
     // Make a working copy of the model
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
@@ -644,6 +816,11 @@ int StaticOptimization::step(const SimTK::State& s, int stepNumber )
 {
     if(!proceed(stepNumber)) return(0);
 
+    if(_numThreads != 1) {
+        deferRecord(s);
+        return(0);
+    }
+
     record(s);
 
     return(0);
@@ -661,6 +838,11 @@ int StaticOptimization::end( const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    if(_numThreads != 1) {
+        deferRecord(s);
+        return recordDeferred();
+    }
+
     record(s);
 
     return(0);
@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -46,6 +47,18 @@ class ForceSet;
  * This class implements static optimization to compute Muscle Forces and 
  * activations. 
  *
+ * The optimization problem at each time is independent of the others apart
+ * from warm-starting muscle activations from the previous time. Setting
+ * num_threads to a value other than 1 defers the optimizations until
+ * end() is called and then solves them in parallel: the times are split into
+ * contiguous blocks, and each thread solves its block in time order using its
+ * own copy of the model. The results are merged, in time order, into the same
+ * activation and force storages used in serial mode. Each block warm-starts
+ * from the activations the model had when the deferral began, not from the
+ * solution at the end of the previous block, so results may differ slightly
+ * from the serial results. Each optimization uses its own SimTK::Optimizer
+ * (and so its own IPOPT instance), so the solves run concurrently.
+ *
  * @author Jeff Reinbolt
  */
 class OSIMANALYSES_API StaticOptimization : public Analysis {
@@ -76,6 +89,12 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
+    PropertyBool _useAnalyticConstraintJacobianProp;
+    bool &_useAnalyticConstraintJacobian;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -93,6 +112,12 @@ protected:
 
     Model *_modelWorkingCopy;
 
+    // Times, generalized coordinates, and generalized speeds whose
+    // optimizations are deferred until end() when running in parallel.
+    std::vector<double> _deferredTimes;
+    std::vector<SimTK::Vector> _deferredQs;
+    std::vector<SimTK::Vector> _deferredUs;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -114,6 +139,12 @@ private:
     void constructColumnLabels();
     void allocateStorage();
     void deleteStorage();
+    int solveAtTime(Model& model, ForceSet& forceSet,
+            ForceReporter& forceReporter, Storage& activationStorage,
+            SimTK::Vector& parameters, double time, const SimTK::Vector& q,
+            const SimTK::Vector& u) const;
+    void deferRecord(const SimTK::State& s);
+    int recordDeferred();
 
 public:
     //--------------------------------------------------------------------------
@@ -135,6 +166,18 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** Set the number of threads used to solve the optimizations at each
+    time. The default (1) solves the optimizations serially as each state is
+    received. A value less than 1 uses all available hardware threads. */
+    void setNumThreads(const int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+    /** If true, the acceleration constraint matrix at each time is assembled
+    from the actuators' moment arms and a solve with the mass matrix instead
+    of realizing the model to Acceleration once per actuator. This is used
+    only when the model has no kinematic constraints in use. See
+    StaticOptimizationTarget::setUseAnalyticConstraintJacobian(). */
+    void setUseAnalyticConstraintJacobian(const bool useIt) { _useAnalyticConstraintJacobian = useIt; }
+    bool getUseAnalyticConstraintJacobian() const { return _useAnalyticConstraintJacobian; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
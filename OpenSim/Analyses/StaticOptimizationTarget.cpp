@@ -30,6 +30,8 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 
 using namespace OpenSim;
@@ -65,6 +67,7 @@ StaticOptimizationTarget(const SimTK::State& s, Model *aModel,int aNP,int aNC, b
     _recipOptForceSquared.setSize(aNP);
     _optimalForce.setSize(aNP);
     _useMusclePhysiology=useMusclePhysiology;
+    _useAnalyticConstraintJacobian=false;
 
     setModel(*aModel);
     setNumParams(aNP);
@@ -127,7 +130,16 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
+    // Fill in the columns that can be computed from the actuators'
+    // generalized forces; the remaining columns are computed by perturbing
+    // each actuator's force and realizing to Acceleration.
+    std::vector<bool> isComputed(np, false);
+    if(_useAnalyticConstraintJacobian && s.getNMultipliers() == 0) {
+        computeAnalyticConstraintMatrix(s, isComputed);
+    }
+
     for(int p=0; p<np; p++) {
+        if(isComputed[p]) continue;
         pVector[p] = 1;
         computeConstraintVector(s, pVector, cVector);
         for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
@@ -138,6 +150,68 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Compute the columns of the linear constraint matrix for actuators whose
+ * generalized forces are available without realizing to Acceleration.
+ * Applying an actuator's optimal force gives generalized forces tau (from the
+ * moment arms of a muscle or PathActuator, or directly for a
+ * CoordinateActuator), and the corresponding change in accelerations is
+ * M^-1 tau. This assumes there are no kinematic constraints in use.
+ *
+ * @param s State realized to at least Velocity.
+ * @param isComputed Set to true for each column that was computed.
+ */
+void StaticOptimizationTarget::
+computeAnalyticConstraintMatrix(const SimTK::State& s, std::vector<bool>& isComputed)
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    int nc = getNumConstraints();
+    int nu = s.getNU();
+
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    Vector mobilityForces(nu), generalizedForces(nu), udot(nu);
+
+    const ForceSet& fSet = _model->getForceSet();
+    for(int i=0, p=0;i<fSet.getSize();i++) {
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+        const int j = p++;
+
+        bodyForces.setToZero();
+        mobilityForces.setToZero();
+        if(CoordinateActuator* coordAct = dynamic_cast<CoordinateActuator*>(act)) {
+            if(!coordAct->isCoordinateValid()) continue;
+            const Coordinate& coord = *coordAct->getCoordinate();
+            matter.addInMobilityForce(s,
+                    SimTK::MobilizedBodyIndex(coord.getBodyIndex()),
+                    SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                    _optimalForce[j], mobilityForces);
+        } else if(dynamic_cast<Muscle*>(act) ||
+                act->getConcreteClassName() == "PathActuator") {
+            // Other PathActuators may not apply the overridden actuation
+            // along their path, so they are left to the perturbation.
+            const GeometryPath& path =
+                    static_cast<PathActuator*>(act)->getGeometryPath();
+            path.addInEquivalentForces(s, _optimalForce[j], bodyForces,
+                    mobilityForces);
+        } else {
+            continue;
+        }
+
+        // f = ~J(q) * F, then udot = M^-1 * f.
+        matter.multiplyBySystemJacobianTranspose(s, bodyForces,
+                generalizedForces);
+        generalizedForces += mobilityForces;
+        matter.multiplyByMInv(s, generalizedForces, udot);
+
+        // The constraints are (target - actual) accelerations.
+        for(int c=0; c<nc; c++) {
+            _constraintMatrix(c,j) = -udot[_accelerationIndices[c]];
+        }
+        isComputed[j] = true;
+    }
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
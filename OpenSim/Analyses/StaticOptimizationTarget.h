@@ -30,6 +30,7 @@
 #include "OpenSim/Common/Array.h"
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <simmath/Optimizer.h>
+#include <vector>
 
 //=============================================================================
 //=============================================================================
@@ -71,6 +72,7 @@ private:
 protected:
     double _activationExponent;
     bool   _useMusclePhysiology;
+    bool   _useAnalyticConstraintJacobian;
     /** Perturbation size for computing numerical derivatives. */
     Array<double> _dx;
     Array<int> _accelerationIndices;
@@ -96,6 +98,14 @@ public:
     double getActivationExponent() const { return _activationExponent; }
     void setCurrentState( const SimTK::State* state) { _currentState = state; }
     const SimTK::State* getCurrentState() const { return _currentState; }
+    /** If true, the columns of the linear constraint matrix for muscles,
+    PathActuators and CoordinateActuators are computed from the generalized
+    forces the actuators apply (i.e., their moment arms) and a solve with the
+    mass matrix, rather than by realizing the system to Acceleration once per
+    actuator. This is only possible if the model has no kinematic constraints
+    in use; otherwise, all columns are computed by perturbation. */
+    void setUseAnalyticConstraintJacobian(bool useIt) { _useAnalyticConstraintJacobian = useIt; }
+    bool getUseAnalyticConstraintJacobian() const { return _useAnalyticConstraintJacobian; }
 
     // UTILITY
     void validatePerturbationSize(double &aSize);
@@ -124,6 +134,7 @@ public:
 private:
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
     void computeAcceleration(SimTK::State& s, const SimTK::Vector &aF,SimTK::Vector &rAccel) const;
+    void computeAnalyticConstraintMatrix(const SimTK::State& s, std::vector<bool>& isComputed);
     void cumulativeTime(double &aTime, double aIncrement);
 };
 
@@ -29,7 +29,13 @@
 
 
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include "Exception.h"
 #include "Logger.h"
 
@@ -54,11 +60,20 @@
  * assignment operator (=), equality operator (==), less than
  * operator (<), and the output operator (<<).
  *
+ * If T is derived from Object, looking up an element by name (getIndex(),
+ * get()) uses a hash table from names to indices. The table is rebuilt
+ * lazily after the array is modified or after one of its elements is renamed.
+ * Renames are detected through a flag that the array registers with each
+ * element when it builds the table, and that the element clears when its
+ * name changes.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
 namespace OpenSim { 
 
+class Object;
+
 template<class T> class ArrayPtrs
 {
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -80,6 +95,22 @@ protected:
     /** Array of pointers to objects of type T. */
     T **_array;
 
+#ifndef SWIG
+private:
+    /** Index of the first element with each name, used by getIndex(). This
+    is only valid while _nameIndexIsValid is set. */
+    mutable std::unordered_map<std::string, int> _nameIndex;
+    mutable bool _nameIndexHasDuplicates = false;
+    /** Cleared when the array is modified or when an element is renamed;
+    shared with the elements (see Object::addNameIndexFlag()). */
+    mutable std::shared_ptr<std::atomic<bool>> _nameIndexIsValid;
+    /** Const lookups may be made from multiple threads. */
+    mutable std::mutex _nameIndexMutex;
+    /** Arrays smaller than this are searched linearly, without building the
+    name index. */
+    static const int MinSizeForNameIndex = 16;
+#endif
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -171,6 +202,7 @@ void clearAndDestroy()
     }
 
     _size = 0;
+    invalidateNameIndex();
 }
 
 
@@ -215,6 +247,7 @@ ArrayPtrs<T>& operator=(const ArrayPtrs<T> &aArray)
     // TAKE OWNERSHIP OF MEMORY
     _memoryOwner = true;
 
+    invalidateNameIndex();
     return(*this);
 }
 
@@ -529,6 +562,7 @@ bool setSize(int aSize)
             }
         }
         _size = aSize;
+        invalidateNameIndex();
     }
 
     return(true);
@@ -591,6 +625,48 @@ int getIndex(ConstT *aObject,int aStartIndex=0) const
  * the array, -1 is returned.
  */
 int getIndex(const std::string &aName,int aStartIndex=0) const
+{
+    return getIndexOfName(aName, aStartIndex,
+            std::is_base_of<Object, typename std::remove_cv<T>::type>());
+}
+
+#ifndef SWIG
+private:
+// Objects: use the name index.
+int getIndexOfName(const std::string &aName, int aStartIndex,
+        std::true_type) const
+{
+    if(_size<MinSizeForNameIndex) {
+        return getIndexOfName(aName, aStartIndex, std::false_type());
+    }
+    std::lock_guard<std::mutex> lock(_nameIndexMutex);
+    if(!_nameIndexIsValid || !_nameIndexIsValid->load()) {
+        // A new flag, so that elements removed since the last rebuild no
+        // longer invalidate this index.
+        _nameIndexIsValid = std::make_shared<std::atomic<bool>>(true);
+        _nameIndex.clear();
+        _nameIndex.reserve(_size);
+        _nameIndexHasDuplicates = false;
+        for(int i=0;i<_size;i++) {
+            static_cast<const Object*>(_array[i])->addNameIndexFlag(
+                    _nameIndexIsValid);
+            if(!_nameIndex.emplace(_array[i]->getName(), i).second) {
+                _nameIndexHasDuplicates = true;
+            }
+        }
+    }
+
+    auto it = _nameIndex.find(aName);
+    if(it == _nameIndex.end()) return(-1);
+    // With duplicate names, the result depends on where the search starts.
+    if(_nameIndexHasDuplicates && aStartIndex>0) {
+        return getIndexOfName(aName, aStartIndex, std::false_type());
+    }
+    return(it->second);
+}
+// Other types: search linearly.
+int getIndexOfName(const std::string &aName, int aStartIndex,
+        std::false_type) const
 {
     if(aStartIndex<0) aStartIndex=0;
     if(aStartIndex>=getSize()) aStartIndex=0;
@@ -608,6 +684,25 @@ int getIndex(const std::string &aName,int aStartIndex=0) const
 
     return(-1);
 }
+void invalidateNameIndex()
+{
+    if(_nameIndexIsValid) _nameIndexIsValid->store(false);
+}
+// Add the last element to the name index, if it is valid, rather than
+// rebuilding the index on the next lookup.
+void appendToNameIndex(std::true_type)
+{
+    std::lock_guard<std::mutex> lock(_nameIndexMutex);
+    if(!_nameIndexIsValid || !_nameIndexIsValid->load()) return;
+    const Object* object = static_cast<const Object*>(_array[_size-1]);
+    object->addNameIndexFlag(_nameIndexIsValid);
+    if(!_nameIndex.emplace(object->getName(), _size-1).second) {
+        _nameIndexHasDuplicates = true;
+    }
+}
+void appendToNameIndex(std::false_type) {}
+public:
+#endif
 
 //-----------------------------------------------------------------------------
 // APPEND
@@ -639,6 +734,8 @@ bool append(T *aObject)
     // SET
     _array[_size] = aObject;
     _size++;
+    appendToNameIndex(
+            std::is_base_of<Object, typename std::remove_cv<T>::type>());
 
     return(true);
 }
@@ -719,6 +816,7 @@ bool insert(int aIndex,T *aObject)
     // SET
     _array[aIndex] = aObject;
     _size++;
+    invalidateNameIndex();
 
     return(true);
 }
@@ -759,6 +857,7 @@ bool remove(int aIndex)
         _array[i] = _array[i+1];
     }
     _array[_size] = NULL;
+    invalidateNameIndex();
 
     return(true);
 }
@@ -815,6 +914,7 @@ bool set(int aIndex,T *aObject)
     // SET
     if(getMemoryOwner() && (_array[aIndex]!=NULL)) delete _array[aIndex];
     _array[aIndex] = aObject;
+    invalidateNameIndex();
 
     return(true);
 }
@@ -24,11 +24,18 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <thread>
+#include <vector>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -165,6 +172,355 @@ private:
     std::condition_variable m_inventoryMonitor;
 };
 
+#ifndef SWIG
+/// A bounded first-in-first-out queue for passing objects from one producer
+/// thread to one consumer thread without locks. tryPush() must only be called
+/// from the producer thread, and tryPop() only from the consumer thread.
+/// @ingroup commonutil
+template <typename T> class RingBuffer {
+public:
+    /// The buffer can hold up to `capacity` objects at a time.
+    explicit RingBuffer(std::size_t capacity) : m_slots(capacity + 1) {}
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// Move the value into the buffer, unless the buffer is full, in which
+    /// case this returns false and the value is not modified.
+    bool tryPush(T& value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t next = increment(head);
+        if (next == m_tail.load(std::memory_order_acquire)) return false;
+        m_slots[head] = std::move(value);
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+    /// Move the oldest value in the buffer into `value`, unless the buffer is
+    /// empty, in which case this returns false.
+    bool tryPop(T& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        value = std::move(m_slots[tail]);
+        m_tail.store(increment(tail), std::memory_order_release);
+        return true;
+    }
+    /// This is only exact if neither thread is using the buffer.
+    bool empty() const {
+        return m_tail.load(std::memory_order_acquire) ==
+               m_head.load(std::memory_order_acquire);
+    }
+    std::size_t capacity() const { return m_slots.size() - 1; }
+
+private:
+    std::size_t increment(std::size_t index) const {
+        return index + 1 == m_slots.size() ? 0 : index + 1;
+    }
+    std::vector<T> m_slots;
+    // Written only by the producer.
+    std::atomic<std::size_t> m_head{0};
+    // Written only by the consumer.
+    std::atomic<std::size_t> m_tail{0};
+};
+
+/// Lets a thread wait, without spinning, until a condition on lock-free data
+/// (e.g., "the RingBuffer is not empty") becomes true. wait() checks the
+/// condition a few times before blocking on a condition variable; the threads
+/// that change the data call notify() afterwards. notify() only takes the
+/// mutex if a thread is blocked, so it is cheap for a producer that must not
+/// wait.
+/// @ingroup commonutil
+class IdleWaiter {
+public:
+    IdleWaiter() = default;
+    IdleWaiter(const IdleWaiter&) = delete;
+    IdleWaiter& operator=(const IdleWaiter&) = delete;
+
+    /// Return once ready() returns true. ready() must only read data that is
+    /// followed by a call to notify() whenever it changes.
+    template <typename Predicate>
+    void wait(const Predicate& ready) {
+        for (int i = 0; i < 64; ++i) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_numBlocked;
+        // Pairs with the fence in notify(): either notify() sees the blocked
+        // thread, or ready() sees the change made before notify().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_condition.wait(lock, ready);
+        --m_numBlocked;
+    }
+
+    /// Wake the threads blocked in wait() so that they check their condition
+    /// again. Call this after changing the data that the condition reads.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_numBlocked.load(std::memory_order_relaxed) == 0) return;
+        // A blocked thread holds the mutex until it is in wait(), so taking
+        // the mutex ensures the notification is not missed.
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<int> m_numBlocked{0};
+};
+
+/// This class hands objects from one producer thread to a background thread,
+/// which passes them to a consumer function in the order they were pushed.
+/// This is useful for moving slow bookkeeping (e.g., appending rows to a
+/// table) off a time-critical thread. The objects are passed through a
+/// RingBuffer; push() only waits if the buffer is full. The background thread
+/// blocks (see IdleWaiter) while there is nothing to consume.
+/// An exception thrown by the consumer function is rethrown by the next call
+/// to flush(); the remaining objects are still consumed.
+/// @ingroup commonutil
+template <typename T> class AsyncConsumer {
+public:
+    AsyncConsumer(std::function<void(T&)> consume,
+            std::size_t capacity = 1024)
+            : m_buffer(capacity), m_consume(std::move(consume)),
+              m_thread(&AsyncConsumer::run, this) {}
+    AsyncConsumer(const AsyncConsumer&) = delete;
+    AsyncConsumer& operator=(const AsyncConsumer&) = delete;
+    /// Consume all remaining objects and stop the background thread.
+    /// Exceptions from the consumer function are discarded; call flush()
+    /// first to handle them.
+    ~AsyncConsumer() {
+        m_stop.store(true);
+        m_pushed.notify();
+        m_thread.join();
+    }
+
+    /// Hand an object to the background thread. Only one thread may push.
+    void push(T value) {
+        std::size_t numConsumed = m_numConsumed.load(std::memory_order_acquire);
+        while (!m_buffer.tryPush(value)) {
+            // The buffer is full, so the background thread will consume
+            // another object.
+            m_consumed.wait([&] {
+                return m_numConsumed.load(std::memory_order_acquire) !=
+                       numConsumed;
+            });
+            numConsumed = m_numConsumed.load(std::memory_order_acquire);
+        }
+        ++m_numPushed;
+        m_pushed.notify();
+    }
+
+    /// Wait until all pushed objects have been consumed. Call this from the
+    /// thread that pushes objects.
+    void flush() {
+        m_consumed.wait([this] {
+            return m_numConsumed.load(std::memory_order_acquire) ==
+                   m_numPushed;
+        });
+        if (m_exception) {
+            std::exception_ptr exception = m_exception;
+            m_exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    void run() {
+        T value;
+        while (true) {
+            if (m_buffer.tryPop(value)) {
+                consume(value);
+            } else if (m_stop.load()) {
+                // Consume anything pushed before the stop request.
+                while (m_buffer.tryPop(value)) consume(value);
+                break;
+            } else {
+                m_pushed.wait([this] {
+                    return !m_buffer.empty() || m_stop.load();
+                });
+            }
+        }
+    }
+    void consume(T& value) {
+        try {
+            m_consume(value);
+        } catch (...) {
+            if (!m_exception) m_exception = std::current_exception();
+        }
+        m_numConsumed.fetch_add(1, std::memory_order_release);
+        m_consumed.notify();
+    }
+
+    RingBuffer<T> m_buffer;
+    std::function<void(T&)> m_consume;
+    // Accessed only by the producer.
+    std::size_t m_numPushed = 0;
+    std::atomic<std::size_t> m_numConsumed{0};
+    std::atomic<bool> m_stop{false};
+    // Notified after each push and after the stop request.
+    IdleWaiter m_pushed;
+    // Notified after each object is consumed.
+    IdleWaiter m_consumed;
+    // Written by the consumer before incrementing m_numConsumed.
+    std::exception_ptr m_exception;
+    std::thread m_thread;
+};
+
+/// The number of threads to use for count independent tasks when numThreads
+/// threads are requested. A value of numThreads less than 1 means to use the
+/// number of hardware threads; no more than count threads are used, and at
+/// least one is.
+/// @ingroup commonutil
+inline int getNumThreadsToUse(int numThreads, int count) {
+    if (numThreads < 1) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    return std::max(1, std::min(numThreads, count));
+}
+
+/// Call function(index) for each index in [0, count), distributing the
+/// indices over numThreads threads, one of which is the calling thread. Each
+/// thread takes the next index that has not been processed, so the indices
+/// need not take equally long. A value of numThreads less than 1 means to use
+/// the number of hardware threads; no more than count threads are used.
+/// If the function throws an exception, the remaining indices are skipped and
+/// the first exception is rethrown once all threads are done.
+/// @ingroup commonutil
+template <typename Function>
+void parallelFor(int count, int numThreads, const Function& function) {
+    if (count <= 0) return;
+    numThreads = getNumThreadsToUse(numThreads, count);
+
+    std::atomic<int> next(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    auto work = [&]() {
+        try {
+            int index;
+            while ((index = next++) < count) function(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception) exception = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) thread.join();
+    if (exception) std::rethrow_exception(exception);
+}
+
+/// A fixed set of threads that run the iterations of parallelFor() calls.
+/// Unlike the free function parallelFor(), the threads are created once, when
+/// the pool is constructed, rather than on every call, so the pool suits
+/// work that is split across threads many times per second (e.g., within
+/// the evaluation of a force). The threads wait on a condition variable
+/// between calls. Calls from different threads are run one at a time.
+/// @ingroup commonutil
+class ThreadPool {
+public:
+    /// The pool runs the iterations on numThreads threads, one of which is
+    /// the calling thread. A value of numThreads less than 1 means to use the
+    /// number of hardware threads.
+    explicit ThreadPool(int numThreads) {
+        numThreads = getNumThreadsToUse(
+                numThreads, std::numeric_limits<int>::max());
+        m_threads.reserve(numThreads - 1);
+        for (int ithread = 1; ithread < numThreads; ++ithread) {
+            m_threads.emplace_back(&ThreadPool::run, this);
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    /// The number of threads, including the calling thread.
+    int getNumThreads() const { return (int)m_threads.size() + 1; }
+
+    /// Call function(index) for each index in [0, count), as the free
+    /// function parallelFor() does, using the threads of the pool.
+    template <typename Function>
+    void parallelFor(int count, const Function& function) {
+        if (count <= 0) return;
+        std::lock_guard<std::mutex> callLock(m_callMutex);
+        if (m_threads.empty() || count == 1) {
+            for (int index = 0; index < count; ++index) function(index);
+            return;
+        }
+
+        std::atomic<int> next(0);
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+        auto work = [&]() {
+            try {
+                int index;
+                while ((index = next++) < count) function(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception) exception = std::current_exception();
+                next = count;
+            }
+        };
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_work = work;
+            m_numBusy = (int)m_threads.size();
+            ++m_generation;
+        }
+        m_start.notify_all();
+        work();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_numBusy == 0; });
+            m_work = nullptr;
+        }
+        if (exception) std::rethrow_exception(exception);
+    }
+
+private:
+    void run() {
+        unsigned long long generation = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_start.wait(lock, [&] {
+                return m_stop || m_generation != generation;
+            });
+            if (m_stop) return;
+            generation = m_generation;
+            const std::function<void()> work = m_work;
+            lock.unlock();
+            work();
+            lock.lock();
+            if (--m_numBusy == 0) m_done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    // Held for the duration of a parallelFor() call.
+    std::mutex m_callMutex;
+    // Guards the members below.
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    std::function<void()> m_work;
+    unsigned long long m_generation = 0;
+    int m_numBusy = 0;
+    bool m_stop = false;
+};
+#endif
+
 } // namespace OpenSim
 
 #endif // OPENSIM_COMMONUTILITIES_H_
@@ -216,6 +216,7 @@ void GCVSpline::
 setEqual(const GCVSpline &aSpline)
 {
     setNull();
+    resetFunction();
 
     // VALUES
     _halfOrder = aSpline._halfOrder;
@@ -230,6 +231,18 @@ setEqual(const GCVSpline &aSpline)
     _y = aSpline._y;
     _weights = aSpline._weights;
     _coefficients = aSpline._coefficients;
+
+    // REUSE THE FIT
+    // If the other spline has been fit, its coefficients are up to date, so
+    // this spline can be recreated from them without fitting it again. The
+    // underlying SimTK::Spline is not shared, as its reference count is not
+    // threadsafe.
+    if(aSpline._function!=NULL) {
+        int n = _x.getSize();
+        Vector x(n, &_x[0]);
+        Vector coefficients(n, &_coefficients[0]);
+        _function = new SimTK::Spline(getDegree(), x, coefficients);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -580,6 +593,21 @@ addPoint(double aX, double aY)
     return i;
 }
 
+void GCVSpline::fit() const
+{
+    if(_function==NULL) _function = createSimTKFunction();
+}
+
+void GCVSpline::calcValueAndDerivatives(double x, double& rValue,
+        double& rFirstDerivative, double& rSecondDerivative) const
+{
+    fit();
+    const SimTK::Spline& spline = static_cast<const SimTK::Spline&>(*_function);
+    rValue = spline.calcValue(x);
+    rFirstDerivative = spline.calcDerivative(1, x);
+    rSecondDerivative = spline.calcDerivative(2, x);
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
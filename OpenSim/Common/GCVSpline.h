@@ -233,6 +233,20 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Fit the spline to its data points now rather than the first time it is
+     * evaluated. Different splines may be fit concurrently.
+     */
+    void fit() const;
+#ifndef SWIG
+    /**
+     * Compute the value and the first and second derivatives of the spline
+     * at x. This gives the same results as calcValue() and calcDerivative(),
+     * but avoids their per-call overhead.
+     */
+    void calcValueAndDerivatives(double x, double& rValue,
+            double& rFirstDerivative, double& rSecondDerivative) const;
+#endif
 
 //=============================================================================
 };  // END class GCVSpline
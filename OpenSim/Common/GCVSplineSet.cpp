@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "GCVSplineSet.h"
+#include "CommonUtilities.h"
 #include "GCVSpline.h"
 #include "Storage.h"
 
@@ -63,11 +64,13 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
     const auto& time = table.getIndependentColumn();
     auto labelsToUse = labels;
     if (labelsToUse.empty()) labelsToUse = table.getColumnLabels();
+    ensureCapacity((int)labelsToUse.size());
     for (const auto& label : labelsToUse) {
         const auto& column = table.getDependentColumn(label);
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines();
 }
 
 void GCVSplineSet::setNull() {
@@ -118,8 +121,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +130,27 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT THE SPLINES
+    fitSplines();
+}
+
+void GCVSplineSet::fitSplines() {
+    // Starting threads is only worthwhile if there is enough data.
+    const int n = getSize();
+    long long numPoints = 0;
+    for(int i=0;i<n;i++) numPoints += getGCVSpline(i)->getSize();
+    const int numThreads = numPoints < 10000 ? 1 : -1;
+
+    // The splines are independent, so they can be fit concurrently. A spline
+    // that cannot be fit (e.g., too few points) is left as is, so that the
+    // error is reported when it is evaluated, as it would be without
+    // fitting the splines here.
+    parallelFor(n, numThreads, [this](int i) {
+        try {
+            getGCVSpline(i)->fit();
+        } catch (const std::exception&) {}
+    });
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -215,6 +237,19 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     return(store);
 }
 
+void GCVSplineSet::calcValuesAndDerivatives(double x, SimTK::Vector& rValues,
+        SimTK::Vector& rFirstDerivatives,
+        SimTK::Vector& rSecondDerivatives) const {
+    const int n = getSize();
+    rValues.resize(n);
+    rFirstDerivatives.resize(n);
+    rSecondDerivatives.resize(n);
+    for (int i = 0; i < n; ++i) {
+        getGCVSpline(i)->calcValueAndDerivatives(x, rValues[i],
+                rFirstDerivatives[i], rSecondDerivatives[i]);
+    }
+}
+
 double GCVSplineSet::getMinX() const
 {
     double min = SimTK::Infinity;
@@ -66,6 +66,7 @@ public:
      * Each column in the Storage object is fit with a spline of the specified
      * degree and is named the name of its corresponding column label. Note that
      * column labels in the storage object are assumed to be tab delimited.
+     * The splines are fit in parallel if there is enough data.
      *
      * @param aDegree Degree of the constructed splines (1, 3, 5, or 7).
      * @param aStore Storage object.
@@ -87,7 +88,8 @@ public:
      * states stored in a TimeSeriesTable.
      *
      * Each column in the TimeSeriesTable is fit with a spline of the specified
-     * degree and is named the name of its corresponding column label.  
+     * degree and is named the name of its corresponding column label. The
+     * splines are fit in parallel if there is enough data.
      *
      * @param table TimeSeriesTable object.
      * @param labels Columns to use from TimeSeriesTable.
@@ -125,6 +127,11 @@ private:
      */
     void construct(int aDegree,const Storage *aStore,double aErrorVariance);
 
+    /**
+     * Fit all splines in the set, distributing them over threads.
+     */
+    void fitSplines();
+
 public:
     /**
      * Get the function at a specified index.
@@ -134,6 +141,17 @@ public:
      *         returned.
      */
     GCVSpline* getGCVSpline(int aIndex) const;
+
+    /**
+     * Evaluate the value and the first and second derivatives of every spline
+     * in the set at x, in one call. This is equivalent to calling evaluate()
+     * for each spline and derivative order. The vectors are resized to
+     * getSize().
+     */
+    void calcValuesAndDerivatives(double x, SimTK::Vector& rValues,
+            SimTK::Vector& rFirstDerivatives,
+            SimTK::Vector& rSecondDerivatives) const;
+
     double getMinX() const;
     double getMaxX() const;
 
@@ -38,7 +38,9 @@
 #include "PropertyTransform.h"
 #include "Property_Deprecated.h"
 #include "XMLDocument.h"
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 
 using namespace OpenSim;
 using namespace std;
@@ -55,6 +57,12 @@ std::map<string,string>     Object::_renamedTypesMap;
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 
+namespace {
+    // Guards Object::_nameIndexFlags, since containers holding the same
+    // Object may rebuild their name indexes on different threads.
+    std::mutex nameIndexFlagsMutex;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S)
 //=============================================================================
@@ -185,6 +193,7 @@ Object::Object(SimTK::Xml::Element& aNode)
 Object& Object::operator=(const Object& source)
 {
     if (&source != this) {
+        if (_name != source._name) invalidateNameIndexes();
         _name           = source._name;
         _description    = source._description;
         _authors        = source._authors;
@@ -303,8 +312,35 @@ operator<(const Object& other) const
 void Object::
 setName(const string &aName)
 {
+    if (_name != aName) invalidateNameIndexes();
     _name = aName;
 }
+
+void Object::invalidateNameIndexes() const
+{
+    // Renaming an Object while another thread looks it up is already a
+    // data race, so the unguarded check only skips Objects never indexed.
+    if (_nameIndexFlags.empty()) return;
+    std::lock_guard<std::mutex> lock(nameIndexFlagsMutex);
+    for (const auto& weakFlag : _nameIndexFlags) {
+        if (auto flag = weakFlag.lock()) flag->store(false);
+    }
+    // The containers register again when they rebuild their indexes.
+    _nameIndexFlags.clear();
+}
+
+void Object::addNameIndexFlag(
+        const std::shared_ptr<std::atomic<bool>>& flag) const
+{
+    std::lock_guard<std::mutex> lock(nameIndexFlagsMutex);
+    // Drop the flags of indexes that were since rebuilt or destroyed.
+    _nameIndexFlags.erase(std::remove_if(_nameIndexFlags.begin(),
+            _nameIndexFlags.end(),
+            [](const std::weak_ptr<std::atomic<bool>>& weakFlag) {
+                return weakFlag.expired();
+            }), _nameIndexFlags.end());
+    _nameIndexFlags.push_back(flag);
+}
 //_____________________________________________________________________________
 /**
  * Get the name of this object.
@@ -40,8 +40,11 @@
 #include "PropertyTable.h"
 #include "Property.h"
 
+#include <atomic>
 #include <cstring>
 #include <cassert>
+#include <memory>
+#include <vector>
 
 // DISABLES MULTIPLE INSTANTIATION WARNINGS
 
@@ -538,6 +541,11 @@ public:
     void setInlined(bool aInlined, const std::string &aFileName="");
 
 protected:
+    /** Tell the containers that look up this Object by name (see
+    ArrayPtrs) that its name changed. Call this if a derived class changes a
+    name that Object::getName() does not return (e.g., Storage::setName()). **/
+    void invalidateNameIndexes() const;
+
     /** When an object is initialized using the current values of its
     properties, it can set a flag indicating that it is up to date. This
     flag is automatically cleared when any property is modified. This allows
@@ -829,6 +837,14 @@ protected:
 private:
     void setNull();
 
+    #ifndef SWIG
+    template <class T> friend class ArrayPtrs;
+    /** Called by an ArrayPtrs that indexes this Object by name; the flag is
+    cleared when this Object is renamed. **/
+    void addNameIndexFlag(
+            const std::shared_ptr<std::atomic<bool>>& flag) const;
+    #endif
+
     // Functions to support deserialization. 
     void generateXMLDocument();
 
@@ -907,6 +923,12 @@ private:
     // to another fresh document, also cached for subsequent printing/writing.
     mutable bool            _inlined;
 
+    #ifndef SWIG
+    // Flags of the containers whose name index includes this object (see
+    // addNameIndexFlag()). Not copied with the object.
+    mutable std::vector<std::weak_ptr<std::atomic<bool>>> _nameIndexFlags;
+    #endif
+
 //==============================================================================
 };  // END of class Object
 
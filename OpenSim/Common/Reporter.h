@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 // INCLUDE
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
@@ -168,6 +169,12 @@ protected:
 * the Output values with each row being the value of all outputs at subsequent
 * times determined by the reporting interval.
 *
+* When many outputs are reported at a high rate, appending rows to the table
+* can take a large share of the simulation time. %Set the
+* `report_asynchronously` property to true to append the rows on a background
+* thread instead; the simulation thread then only evaluates the outputs.
+* getTable() waits for all reported rows to be appended.
+*
 * @ingroup reporters
 *
 * @tparam InputT The type for the Reporter's Input (i.e., Reporter<InputT>).
@@ -179,11 +186,17 @@ template<class InputT=SimTK::Real, typename ValueT=InputT>
 class TableReporter_ : public Reporter<InputT> {
 OpenSim_DECLARE_CONCRETE_OBJECT_T(TableReporter_, InputT, Reporter<InputT>);
 public:
-    TableReporter_() = default;
+    OpenSim_DECLARE_PROPERTY(report_asynchronously, bool,
+        "Append rows to the table on a background thread rather than on the "
+        "simulation thread (default: false).");
+
+    TableReporter_() { constructProperty_report_asynchronously(false); }
     virtual ~TableReporter_() = default;
 
-    /** Retrieve the report as a TimeSeriesTable.                             */
+    /** Retrieve the report as a TimeSeriesTable. If reporting
+    asynchronously, this waits until all reported rows have been appended.   */
     const TimeSeriesTable_<ValueT>& getTable() const {
+        if (_asyncConsumer) _asyncConsumer->flush();
         return _outputTable;
     }
 
@@ -191,6 +204,8 @@ public:
     simulation. Each new iteration should start with an empty report and so this
     function can be used to clear the report at the end of each iteration.    */
     void clearTable() {
+        if (_asyncConsumer) _asyncConsumer->flush();
+        _lastReportedTime = -SimTK::Infinity;
         std::vector<std::string> columnLabels;
         // Handle the case where no outputs were connected to the reporter.
         if (_outputTable.hasColumnLabels()) {
@@ -213,16 +228,52 @@ protected:
               const auto& value = chan.getValue(state);
               result[idx] = value;
         }
-        try {
-            const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
-        } catch(const InvalidTimestamp& exception) {
-            OPENSIM_THROW(Exception,
-                          "Attempting to update reporter with rows having "
-                          "invalid timestamps. Hint: If running simulation in "
-                          "a loop, use clearTable() to clear table at the end "
-                          "of each loop.\n\n" + std::string{exception.what()});
+        appendReportedRow(state.getTime(), std::move(result));
+    }
+
+    /** Append a row to the table, either directly or, if reporting
+    asynchronously, through the background thread.                          */
+    void appendReportedRow(double time, SimTK::RowVector_<ValueT> row) const {
+        auto* mutableThis = const_cast<Self*>(this);
+        if (!get_report_asynchronously()) {
+            if (_asyncConsumer) {
+                _asyncConsumer->flush();
+                _asyncConsumer.reset();
+            }
+            try {
+                mutableThis->_outputTable.appendRow(time, row);
+            } catch(const InvalidTimestamp& exception) {
+                OPENSIM_THROW(Exception, getInvalidTimestampHint() +
+                                         std::string{exception.what()});
+            }
+            return;
+        }
+
+        if (!_asyncConsumer) {
+            const auto& times = _outputTable.getIndependentColumn();
+            _lastReportedTime = times.empty() ? -SimTK::Infinity : times.back();
+            _asyncConsumer.reset(new AsyncConsumer<TimeAndRow>(
+                    [mutableThis](TimeAndRow& timeAndRow) {
+                        mutableThis->_outputTable.appendRow(
+                                timeAndRow.first, timeAndRow.second);
+                    }));
         }
+        // Check the time here so that the error occurs during the
+        // simulation, as it does when reporting synchronously.
+        OPENSIM_THROW_IF(time <= _lastReportedTime, Exception,
+                getInvalidTimestampHint() +
+                        fmt::format("Time {} is less-than/equal to the time "
+                                    "of the previous row, {}.",
+                                time, _lastReportedTime));
+        _lastReportedTime = time;
+        _asyncConsumer->push(TimeAndRow(time, std::move(row)));
+    }
+
+    /** Whether any rows have been reported since the table was last cleared
+    (they may not yet have been appended if reporting asynchronously).      */
+    bool hasReportedRows() const {
+        if (_asyncConsumer) return _lastReportedTime > -SimTK::Infinity;
+        return _outputTable.getNumRows() > 0;
     }
 
     void extendFinalizeConnections(Component& root) override {
@@ -246,11 +297,25 @@ protected:
     }
 
 private:
+    static std::string getInvalidTimestampHint() {
+        return "Attempting to update reporter with rows having "
+               "invalid timestamps. Hint: If running simulation in "
+               "a loop, use clearTable() to clear table at the end "
+               "of each loop.\n\n";
+    }
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+
+    // Used only when reporting asynchronously. The consumer is declared after
+    // the table so that it finishes appending rows before the table is
+    // destroyed.
+    using TimeAndRow = std::pair<double, SimTK::RowVector_<ValueT>>;
+    mutable double _lastReportedTime = -SimTK::Infinity;
+    mutable SimTK::ResetOnCopy<std::unique_ptr<AsyncConsumer<TimeAndRow>>>
+            _asyncConsumer;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -350,7 +415,7 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
     const auto& input = getInput<SimTK::Vector>("inputs");
     const SimTK::Vector& result = input.getValue(state, 0);
     
-    if (_outputTable.getNumRows() == 0) {
+    if (!hasReportedRows()) {
         std::vector<std::string> labels;
         const std::string& base = input.getLabel(0);
         for (int ix = 0; ix < result.size(); ++ix) {
@@ -359,8 +424,7 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
         const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
     }
 
-    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
-                                                    (~result).getAsRowVector());
+    appendReportedRow(state.getTime(), (~result).getAsRowVector());
 }
 
 /** @name Commonly used concrete TableReporters */
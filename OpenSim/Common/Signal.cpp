@@ -30,6 +30,7 @@
 #include <math.h>
 #include "Signal.h"
 #include "Array.h"
+#include "CommonUtilities.h"
 #include "SimTKcommon/Constants.h"
 #include "SimTKcommon/Orientation.h"
 #include "SimTKcommon/Scalar.h"
@@ -37,9 +38,76 @@
 #include "simmath/internal/Spline.h"
 #include "simmath/internal/SplineFitter.h"
 
+#include <algorithm>
+#include <atomic>
+
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+
+// Number of neighboring signals that the batch filters process together. The
+// innermost loops of the filters run over the signals of a block.
+constexpr int BATCH_BLOCK_SIZE = 8;
+
+// Number of data points below which the batch filters do not start threads.
+constexpr long long BATCH_POINTS_PER_THREAD = 1 << 15;
+
+// Call processBlock(firstSignal, numSignalsInBlock) for consecutive blocks of
+// blockSize signals, distributing the blocks over numThreads threads.
+template <typename ProcessBlock>
+void forEachSignalBlock(int numPoints, int numSignals, int blockSize,
+        int numThreads, const ProcessBlock& processBlock) {
+    const int numBlocks = (numSignals + blockSize - 1) / blockSize;
+    numThreads = getNumThreadsToUse(numThreads, numBlocks);
+    const long long numThreadsForData = std::max(1LL,
+            (long long)numPoints * numSignals / BATCH_POINTS_PER_THREAD);
+    numThreads = (int)std::min((long long)numThreads, numThreadsForData);
+    parallelFor(numBlocks, numThreads, [&](int iblock) {
+        const int first = iblock * blockSize;
+        processBlock(first, std::min(blockSize, numSignals - first));
+    });
+}
+
+// Coefficients of the 3rd order lowpass IIR Butterworth filter used by
+// Signal::LowpassIIR().
+void calcLowpassIIRCoefficients(double T, double fc, double a[4], double b[4])
+{
+double fs/*,ws*/,wc,wa,wa2,wa3;
+double denom;
+
+    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
+    fs = 1 / T;
+    if (fc >= 0.5 * fs) {
+        fc = 0.49 * fs;
+        log_warn("Cutoff frequency should be less than half sample frequency. "
+                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
+                 "cutoff = {}", fc);
+    }
+
+    // INITIALIZE SOME VARIABLES
+    //ws = 2*SimTK_PI*fs;
+    wc = 2*SimTK_PI*fc;
+
+    // CALCULATE THE FREQUENCY WARPING
+    wa = tan(wc*T/2.0);
+    wa2 = wa*wa;
+    wa3 = wa*wa*wa;
+
+    // GET COEFFICIENTS FOR THE FILTER
+    denom = (wa+1) * (wa*wa + wa + 1.0);
+    a[0] = wa3 / denom;
+    a[1] = 3*wa3 / denom;
+    a[2] = 3*wa3 / denom;
+    a[3] = wa3 / denom;
+    b[0] = 1;
+    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
+    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
+    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
+
+} // anonymous namespace
+
 //=============================================================================
 // FILTERS
 //=============================================================================
@@ -161,8 +229,7 @@ int Signal::
 LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
 {
 int i,j;
-double fs/*,ws*/,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
+double a[4],b[4];
 double *sigr;
 
     // ERROR CHECK
@@ -171,34 +238,8 @@ double *sigr;
     if(sig==NULL) return(-1);
     if(sigf==NULL) return(-1);
 
-    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
-    fs = 1 / T;
-    if (fc >= 0.5 * fs) {
-        fc = 0.49 * fs;
-        log_warn("Cutoff frequency should be less than half sample frequency. "
-                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
-                 "cutoff = {}", fc);
-    }
-
-    // INITIALIZE SOME VARIABLES
-    //ws = 2*SimTK_PI*fs;
-    wc = 2*SimTK_PI*fc;
-
-    // CALCULATE THE FREQUENCY WARPING
-    wa = tan(wc*T/2.0);
-    wa2 = wa*wa;
-    wa3 = wa*wa*wa;
-
     // GET COEFFICIENTS FOR THE FILTER
-    denom = (wa+1) * (wa*wa + wa + 1.0);
-    a[0] = wa3 / denom;
-    a[1] = 3*wa3 / denom;
-    a[2] = 3*wa3 / denom;
-    a[3] = wa3 / denom;
-    b[0] = 1;
-    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
-    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
-    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+    calcLowpassIIRCoefficients(T,fc,a,b);
 
     // ALLOCATE MEMORY FOR sigr[]
     sigr = new double[N];
@@ -394,6 +435,179 @@ double *s;
   return(0);
 }
 
+//=============================================================================
+// BATCH FILTERS
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Spline-smooth each of the signals stored column-major in sigs. Each signal
+ * is smoothed with SmoothSpline(), so the signals are distributed over the
+ * threads one at a time.
+ *
+ * @return 0 on success, and -1 if smoothing any of the signals failed.
+ */
+int Signal::
+SmoothSpline(int degree,double T,double fc,int N,const double *times,
+        int numSigs,const double *sigs,double *sigfs,int numThreads)
+{
+    if(numSigs<0) return(-1);
+    if(numSigs==0) return(0);
+    if(times==NULL || sigs==NULL || sigfs==NULL) return(-1);
+
+    std::atomic<bool> failed(false);
+    forEachSignalBlock(N,numSigs,1,numThreads,
+            [&](int isig,int) {
+        // SmoothSpline() does not modify the times or the signal.
+        const int status = SmoothSpline(degree,T,fc,N,
+                const_cast<double*>(times),
+                const_cast<double*>(sigs + (size_t)isig*N),
+                sigfs + (size_t)isig*N);
+        if(status!=0) failed = true;
+    });
+
+    return failed ? -1 : 0;
+}
+//_____________________________________________________________________________
+/**
+ * Filter each of the signals stored column-major in sigs with the filter used
+ * by LowpassIIR(). The forward and backward passes of the filter are applied
+ * in place of reversing the signals, with the same arithmetic as LowpassIIR().
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int numSigs,const double *sigs,
+        double *sigfs,int numThreads)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(numSigs<0) return(-1);
+    if(numSigs==0) return(0);
+    if(sigs==NULL || sigfs==NULL) return(-1);
+
+    // GET COEFFICIENTS FOR THE FILTER
+    double a[4],b[4];
+    calcLowpassIIRCoefficients(T,fc,a,b);
+
+    forEachSignalBlock(N,numSigs,BATCH_BLOCK_SIZE,numThreads,
+            [&](int first,int B) {
+        // INTERLEAVE THE SIGNALS OF THE BLOCK: x[i*B + c]
+        std::vector<double> x((size_t)N*B), y((size_t)N*B);
+        for(int c=0;c<B;c++) {
+            const double *sig = sigs + (size_t)(first+c)*N;
+            for(int i=0;i<N;i++) x[(size_t)i*B + c] = sig[i];
+        }
+
+        // FORWARD PASS
+        for(int i=0;i<3*B;i++) y[i] = x[i];
+        for(int i=3;i<N;i++) {
+            const double *x0 = &x[(size_t)i*B];
+            const double *x1 = x0-B, *x2 = x1-B, *x3 = x2-B;
+            double *y0 = &y[(size_t)i*B];
+            const double *y1 = y0-B, *y2 = y1-B, *y3 = y2-B;
+            for(int c=0;c<B;c++) {
+                y0[c] = a[0]*x0[c] + a[1]*x1[c] +  a[2]*x2[c] +  a[3]*x3[c]
+                                   - b[1]*y1[c] - b[2]*y2[c] - b[3]*y3[c];
+            }
+        }
+
+        // BACKWARD PASS, STORED IN x
+        for(int i=N-3;i<N;i++) {
+            for(int c=0;c<B;c++) x[(size_t)i*B + c] = y[(size_t)i*B + c];
+        }
+        for(int i=N-4;i>=0;i--) {
+            const double *y0 = &y[(size_t)i*B];
+            const double *y1 = y0+B, *y2 = y1+B, *y3 = y2+B;
+            double *z0 = &x[(size_t)i*B];
+            const double *z1 = z0+B, *z2 = z1+B, *z3 = z2+B;
+            for(int c=0;c<B;c++) {
+                z0[c] = a[0]*y0[c] + a[1]*y1[c] +  a[2]*y2[c] +  a[3]*y3[c]
+                                   - b[1]*z1[c] - b[2]*z2[c] - b[3]*z3[c];
+            }
+        }
+
+        // DE-INTERLEAVE
+        for(int c=0;c<B;c++) {
+            double *sigf = sigfs + (size_t)(first+c)*N;
+            for(int i=0;i<N;i++) sigf[i] = x[(size_t)i*B + c];
+        }
+    });
+
+  return(0);
+}
+//_____________________________________________________________________________
+/**
+ * Filter each of the signals stored column-major in sigs with the filter used
+ * by LowpassFIR(). The filter coefficients are computed once for all signals.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassFIR(int M,double T,double f,int N,int numSigs,const double *sigs,
+        double *sigfs,int numThreads)
+{
+    // CHECK THAT M IS NOT TOO LARGE RELATIVE TO N
+    if((M+M)>N) {
+        log_error("Signal.LowpassFIR: The number of data points ({}) "
+                  "should be at least twice the order of the filter ({}).",
+                N, M);
+        return(-1);
+    }
+    if(numSigs<0) return(-1);
+    if(numSigs==0) return(0);
+    if(sigs==NULL || sigfs==NULL) return(-1);
+
+    // CALCULATE THE ANGULAR CUTOFF FREQUENCY
+    double w = 2.0*SimTK_PI*f;
+
+    // CALCULATE THE FILTER COEFFICIENTS
+    std::vector<double> coefs(2*M+1);
+    double sum_coef = 0.0;
+    for(int k=-M;k<=M;k++) {
+        double x = (double)k*w*T;
+        double coef = (sinc(x)*T*w/SimTK_PI)*hamming(k,M);
+        coefs[k+M] = coef;
+        sum_coef = sum_coef + coef;
+    }
+
+    forEachSignalBlock(N,numSigs,BATCH_BLOCK_SIZE,numThreads,
+            [&](int first,int B) {
+        // PAD AND INTERLEAVE THE SIGNALS OF THE BLOCK, AS IN Pad()
+        const int size = N + 2*M;
+        std::vector<double> s((size_t)size*B);
+        for(int c=0;c<B;c++) {
+            const double *sig = sigs + (size_t)(first+c)*N;
+            for(int i=0;i<M;i++) s[(size_t)i*B + c] = 2.0*sig[0] - sig[M-i];
+            for(int i=0;i<N;i++) s[(size_t)(M+i)*B + c] = sig[i];
+            for(int i=0;i<M;i++) {
+                s[(size_t)(M+N+i)*B + c] = 2.0*sig[N-1] - sig[N-2-i];
+            }
+        }
+
+        // FILTER THE DATA
+        std::vector<double> sigf((size_t)N*B);
+        for(int n=0;n<N;n++) {
+            double *acc = &sigf[(size_t)n*B];
+            for(int c=0;c<B;c++) acc[c] = 0.0;
+            for(int k=-M;k<=M;k++) {
+                const double coef = coefs[k+M];
+                const double *sp = &s[(size_t)(M+n-k)*B];
+                for(int c=0;c<B;c++) acc[c] = acc[c] + coef*sp[c];
+            }
+            for(int c=0;c<B;c++) acc[c] = acc[c] / sum_coef;
+        }
+
+        // DE-INTERLEAVE
+        for(int c=0;c<B;c++) {
+            double *out = sigfs + (size_t)(first+c)*N;
+            for(int n=0;n<N;n++) out[n] = sigf[(size_t)n*B + c];
+        }
+    });
+
+  return 0;
+}
+
 std::vector<double> Signal::
 Pad(int aPad,int aN,const double aSignal[])
 {
@@ -72,6 +72,38 @@ public:
         double aLowFrequency,double aHighFrequency,
         int aN,double *aSignal,double *aFilteredSignal);
 
+    //--------------------------------------------------------------------------
+    // BATCH FILTERS
+    //--------------------------------------------------------------------------
+    /// @name Batch filters
+    /// These filter aNumSignals signals of aN points each, stored one after
+    /// the other (column-major) in aSignals, and produce results that are
+    /// identical to filtering each signal with the corresponding single-signal
+    /// filter above (unless the compiler is allowed to contract multiplies and
+    /// adds into fused multiply-adds, e.g., with -mfma). The signals are
+    /// filtered in blocks of neighboring signals whose inner loops run across
+    /// the signals of the block (which the compiler can vectorize), and the
+    /// blocks are distributed over aNumThreads threads (default: 1, so that
+    /// callers that already run on several threads do not oversubscribe the
+    /// processor). A value of aNumThreads less than 1 means to use the number
+    /// of hardware threads; fewer threads are used if there is little data.
+    /// aSignals and rFilteredSignals may be the same array.
+    /// @return 0 on success, and -1 on failure.
+    /// @{
+    static int
+        SmoothSpline(int aDegree,double aDeltaT,double aCutOffFrequency,
+        int aN,const double *aTimes,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    static int
+        LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    /// @}
+
     //--------------------------------------------------------------------------
     // PADDING
     //--------------------------------------------------------------------------
@@ -41,6 +41,7 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace OpenSim;
@@ -94,10 +95,15 @@ void convertTableToStorage(const AbstractDataTable* table, Storage& sto)
     sto.setColumnLabels(labels);
 
     const auto& times = out.getIndependentColumn();
+    const auto& matrix = out.getMatrix();
+    const int numColumns = matrix.ncol();
+    StateVector vec;
+    vec.getData().setSize(numColumns);
     for (unsigned i_time = 0; i_time < out.getNumRows(); ++i_time) {
-        const SimTK::Vector rowVector =
-            out.getRowAtIndex(i_time).transpose().getAsVector();
-        sto.append(times[i_time], rowVector);
+        vec.setTime(times[i_time]);
+        Array<double>& data = vec.getData();
+        for (int j = 0; j < numColumns; ++j) data[j] = matrix(i_time, j);
+        sto.append(vec);
     }
 }
 
@@ -565,28 +571,17 @@ parseColumnLabels(const char *aLabels)
     int len = (int)strlen(aLabels);
     if(len==0) return;
 
-    // SET NEW
-    char *labelsCopy = new char[len+1];
-    if(aLabels[len-1]=='\n') {
-        // strip carriage return
-        strncpy(labelsCopy,aLabels,len-1);
-        labelsCopy[len-1] = 0;
-    } else {
-        strcpy(labelsCopy,aLabels);
-    }
-
-    // Parse
-    char *token = strtok(labelsCopy,DEFAULT_HEADER_SEPARATOR );
-    while(token!=NULL)
-    {
+    // Parse (without strtok(), so that files can be read concurrently)
+    const std::string labels(aLabels, len);
+    std::string::size_type begin =
+            labels.find_first_not_of(DEFAULT_HEADER_SEPARATOR);
+    while(begin != std::string::npos) {
+        const std::string::size_type end =
+                labels.find_first_of(DEFAULT_HEADER_SEPARATOR, begin);
         // Append column label
-        _columnLabels.append(token);
-
-        // Get next label
-        token = strtok( NULL, DEFAULT_HEADER_SEPARATOR );
+        _columnLabels.append(labels.substr(begin, end - begin));
+        begin = labels.find_first_not_of(DEFAULT_HEADER_SEPARATOR, end);
     }
-
-    delete[] labelsCopy;
 }
 
 //_____________________________________________________________________________
@@ -1332,28 +1327,50 @@ Storage::getColumnIndicesForIdentifier(const std::string& identifier) const
 TimeSeriesTable Storage::exportToTable() const {
     TimeSeriesTable table{};
 
-    table.addTableMetaData("header", getName());
-    table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
-    table.addTableMetaData("nRows", std::to_string(_storage.getSize()));
-    table.addTableMetaData("nColumns", std::to_string(_columnLabels.getSize()));
-    if(!getDescription().empty())
-        table.addTableMetaData("description", getDescription());
-
     // Exclude the first column label. It is 'time'. Time is a separate column
     // in TimeSeriesTable and column label is optional.
+    std::vector<std::string> labels;
     if (_columnLabels.size() > 1) {
-        table.setColumnLabels(_columnLabels.get() + 1,
+        labels.assign(_columnLabels.get() + 1,
                 _columnLabels.get() + _columnLabels.getSize());
     }
 
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
-        // Exclude the first column. It is 'time'. Time is a separate column in
-        // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
+    // If every row has a value for every column, fill the dependent data in
+    // one pass rather than appending rows, which would reallocate the table's
+    // matrix for every row.
+    const int nRows = _storage.getSize();
+    const int nColumns = (int)labels.size();
+    bool allRowsMatch = nRows > 0 && nColumns > 0;
+    for(int i = 0; allRowsMatch && i < nRows; ++i) {
+        allRowsMatch = _storage[i].getSize() == nColumns;
+    }
+    if (allRowsMatch) {
+        std::vector<double> times(nRows);
+        SimTK::Matrix data(nRows, nColumns);
+        for(int i = 0; i < nRows; ++i) {
+            const auto& row = _storage[i].getData();
+            times[i] = _storage[i].getTime();
+            for(int j = 0; j < nColumns; ++j) data(i, j) = row[j];
+        }
+        table = TimeSeriesTable(times, data, labels);
+    } else {
+        if (!labels.empty()) table.setColumnLabels(labels);
+        for(int i = 0; i < nRows; ++i) {
+            const auto& row = getStateVector(i)->getData();
+            const auto time = getStateVector(i)->getTime();
+            // Exclude the first column. It is 'time'. Time is a separate
+            // column in TimeSeriesTable.
+            table.appendRow(time, row.get(), row.get() + row.getSize());
+        }
     }
 
+    table.addTableMetaData("header", getName());
+    table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
+    table.addTableMetaData("nRows", std::to_string(_storage.getSize()));
+    table.addTableMetaData("nColumns", std::to_string(_columnLabels.getSize()));
+    if(!getDescription().empty())
+        table.addTableMetaData("description", getDescription());
+
     return table;
 }
 
@@ -2331,25 +2348,29 @@ pad(int aPadSize)
 
     // PAD EACH COLUMN
     int nc = getSmallestNumberOfStates();
+    std::vector<double> columns;
+    getDataColumns(nc, columns);
+    std::vector<double> paddedColumns((size_t)nc*newSize);
     Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
-    for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
-    }
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
+        paddedSignal.setSize(size);
+        std::copy_n(&columns[(size_t)i*size], size, &paddedSignal[0]);
         Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
+        std::copy_n(&paddedSignal[0], newSize,
+                &paddedColumns[(size_t)i*newSize]);
     }
 
-    // APPEND THE STATEVECTORS
+    // REPLACE THE STATEVECTORS
     _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
-
-    // CLEANUP
-    delete[] vecs;
+    _storage.ensureCapacity(newSize);
+    StateVector vec;
+    vec.getData().setSize(nc);
+    for(int j=0;j<newSize;j++) {
+        vec.setTime(paddedTime[j]);
+        Array<double>& data = vec.getData();
+        for(int i=0;i<nc;i++) data[i] = paddedColumns[(size_t)i*newSize + j];
+        _storage.append(vec);
+    }
 }
 
 void Storage::
@@ -2378,18 +2399,15 @@ smoothSpline(int aOrder,double aCutoffFrequency)
     // LOOP OVER COLUMNS
     double *times=NULL;
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    std::vector<double> columns, filtered((size_t)nc*size);
+    getDataColumns(nc, columns);
     getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
+    Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,nc,
+            columns.data(),filtered.data());
+    setDataColumns(nc, filtered);
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 void Storage::
@@ -2417,16 +2435,11 @@ lowpassIIR(double aCutoffFrequency)
 
     // LOOP OVER COLUMNS
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    std::vector<double> columns, filtered((size_t)nc*size);
+    getDataColumns(nc, columns);
+    Signal::LowpassIIR(dtmin,aCutoffFrequency,size,nc,columns.data(),
+            filtered.data());
+    setDataColumns(nc, filtered);
 }
 
 void Storage::
@@ -2454,16 +2467,41 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
 
     // LOOP OVER COLUMNS
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
+    std::vector<double> columns, filtered((size_t)nc*size);
+    getDataColumns(nc, columns);
+    Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,nc,columns.data(),
+            filtered.data());
+    setDataColumns(nc, filtered);
+}
 
-    // CLEANUP
-    delete[] signal;
+//_____________________________________________________________________________
+/**
+ * Copy the first aNumColumns states of all state vectors into a column-major
+ * buffer, reading each state vector once.
+ */
+void Storage::
+getDataColumns(int aNumColumns, std::vector<double>& rColumns) const
+{
+    const int n = _storage.getSize();
+    rColumns.resize((size_t)aNumColumns*n);
+    for(int i=0;i<n;i++) {
+        const Array<double>& data = _storage[i].getData();
+        for(int j=0;j<aNumColumns;j++) rColumns[(size_t)j*n + i] = data[j];
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Copy a column-major buffer from getDataColumns() back into the state
+ * vectors, writing each state vector once.
+ */
+void Storage::
+setDataColumns(int aNumColumns, const std::vector<double>& aColumns)
+{
+    const int n = _storage.getSize();
+    for(int i=0;i<n;i++) {
+        Array<double>& data = _storage[i].getData();
+        for(int j=0;j<aNumColumns;j++) data[j] = aColumns[(size_t)j*n + i];
+    }
 }
 
 
@@ -2519,11 +2557,15 @@ int Storage::
 findIndex(double aT) const
 {
     if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
+    // Bisect for the first state vector with a time greater than aT; the
+    // times are assumed to be nondecreasing.
+    int lo = 0, hi = _storage.getSize();
+    while(lo<hi) {
+        const int mid = lo + (hi-lo)/2;
+        if(aT<_storage[mid].getTime()) hi = mid;
+        else lo = mid + 1;
+    }
+    _lastI = lo-1;
     if(_lastI<0) _lastI=0;
     return(_lastI);
 }
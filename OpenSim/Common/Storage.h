@@ -140,7 +140,10 @@ public:
 
     const std::string& getName() const { return _name; };
     const std::string& getDescription() const { return _description; };
-    void setName(const std::string& aName) { _name = aName; };
+    void setName(const std::string& aName) {
+        if (_name != aName) invalidateNameIndexes();
+        _name = aName;
+    };
     void setDescription(const std::string& aDescription) { _description = aDescription; };
     //--------------------------------------------------------------------------
     // VERSIONING /BACKWARD COMPATIBILITY SUPPORT
@@ -374,6 +377,13 @@ private:
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    // Copy the first aNumColumns states of all state vectors into a
+    // column-major buffer (rColumns[j*getSize() + i] is state j at time
+    // index i) so that column operations can work on contiguous memory.
+    // Each state vector must have at least aNumColumns states.
+    void getDataColumns(int aNumColumns, std::vector<double>& rColumns) const;
+    // Inverse of getDataColumns().
+    void setDataColumns(int aNumColumns, const std::vector<double>& aColumns);
 
 //=============================================================================
 };  // END of class Storage
@@ -119,17 +119,11 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     return -1;
 }
 
-void TableUtilities::filterLowpass(
-        TimeSeriesTable& table, double cutoffFreq, bool padData) {
-    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
-            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
-
-    if (padData) { pad(table, (int)table.getNumRows() / 2); }
-
+namespace {
+// Resample the table if its sampling interval is not uniform, and return the
+// sampling interval.
+double resampleUniformly(TimeSeriesTable& table) {
     const int numRows = (int)table.getNumRows();
-    OPENSIM_THROW_IF(numRows < 4, Exception,
-            "Expected at least 4 rows to filter, but got {} rows.", numRows);
-
     const auto& time = table.getIndependentColumn();
 
     double dtMin = SimTK::Infinity;
@@ -144,17 +138,102 @@ void TableUtilities::filterLowpass(
 
     // Resample if the sampling interval is not uniform.
     if (dtAvg - dtMin > SimTK::Eps) {
-        table = resampleWithInterval(table, dtMin);
+        table = TableUtilities::resampleWithInterval(table, dtMin);
     }
+    return dtMin;
+}
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+// Copy the dependent data of the table into a column-major buffer, as expected
+// by the batch filters in Signal.
+std::vector<double> getColumnMajorData(const TimeSeriesTable& table) {
+    const int numRows = (int)table.getNumRows();
+    const int numColumns = (int)table.getNumColumns();
+    const auto& matrix = table.getMatrix();
+    std::vector<double> data((size_t)numRows * numColumns);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        double* column = data.data() + (size_t)icol * numRows;
+        for (int irow = 0; irow < numRows; ++irow) {
+            column[irow] = matrix(irow, icol);
+        }
     }
+    return data;
+}
+
+void setColumnMajorData(TimeSeriesTable& table, const std::vector<double>& data) {
+    const int numRows = (int)table.getNumRows();
+    const int numColumns = (int)table.getNumColumns();
+    auto& matrix = table.updMatrix();
+    for (int icol = 0; icol < numColumns; ++icol) {
+        const double* column = data.data() + (size_t)icol * numRows;
+        for (int irow = 0; irow < numRows; ++irow) {
+            matrix(irow, icol) = column[irow];
+        }
+    }
+}
+} // anonymous namespace
+
+void TableUtilities::filterLowpass(TimeSeriesTable& table, double cutoffFreq,
+        bool padData, int numThreads) {
+    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
+            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
+
+    if (padData) { pad(table, (int)table.getNumRows() / 2); }
+
+    OPENSIM_THROW_IF(table.getNumRows() < 4, Exception,
+            "Expected at least 4 rows to filter, but got {} rows.",
+            table.getNumRows());
+
+    const double dt = resampleUniformly(table);
+
+    std::vector<double> data = getColumnMajorData(table);
+    Signal::LowpassIIR(dt, cutoffFreq, (int)table.getNumRows(),
+            (int)table.getNumColumns(), data.data(), data.data(), numThreads);
+    setColumnMajorData(table, data);
+}
+
+void TableUtilities::filterLowpassFIR(TimeSeriesTable& table, int order,
+        double cutoffFreq, bool padData, int numThreads) {
+    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
+            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
+    OPENSIM_THROW_IF(order < 0, Exception,
+            "Filter order must be non-negative; got {}.", order);
+
+    if (padData) { pad(table, (int)table.getNumRows() / 2); }
+
+    OPENSIM_THROW_IF((int)table.getNumRows() < std::max(2 * order, 2),
+            Exception,
+            "Expected at least {} rows to filter with order {}, but got {} "
+            "rows.",
+            std::max(2 * order, 2), order, table.getNumRows());
+
+    // Resampling does not reduce the number of rows.
+    const double dt = resampleUniformly(table);
+    const int numRows = (int)table.getNumRows();
+
+    std::vector<double> data = getColumnMajorData(table);
+    Signal::LowpassFIR(order, dt, cutoffFreq, numRows,
+            (int)table.getNumColumns(), data.data(), data.data(), numThreads);
+    setColumnMajorData(table, data);
+}
+
+void TableUtilities::smoothSpline(TimeSeriesTable& table, int degree,
+        double cutoffFreq, int numThreads) {
+    OPENSIM_THROW_IF(cutoffFreq <= 0, Exception,
+            "Cutoff frequency must be positive; got {}.", cutoffFreq);
+    OPENSIM_THROW_IF(degree != 1 && degree != 3 && degree != 5 && degree != 7,
+            Exception, "Spline degree must be 1, 3, 5 or 7; got {}.", degree);
+    OPENSIM_THROW_IF((int)table.getNumRows() < 2 * degree, Exception,
+            "Expected at least {} rows to smooth with a spline of degree {}, "
+            "but got {} rows.",
+            2 * degree, degree, table.getNumRows());
+
+    const double dt = resampleUniformly(table);
+
+    std::vector<double> data = getColumnMajorData(table);
+    Signal::SmoothSpline(degree, dt, cutoffFreq, (int)table.getNumRows(),
+            table.getIndependentColumn().data(), (int)table.getNumColumns(),
+            data.data(), data.data(), numThreads);
+    setColumnMajorData(table, data);
 }
 
 void TableUtilities::pad(
@@ -63,9 +63,27 @@ public:
     /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff
     /// frequency. If padData is true, then the data is first padded with pad()
     /// using numRowsToPrependAndAppend = table.getNumRows() / 2.
-    /// The filtering is performed with Signal::LowpassIIR()
+    /// The filtering is performed with Signal::LowpassIIR(), for blocks of
+    /// columns in parallel on numThreads threads (see the batch filters in
+    /// Signal). By default, one thread is used; a value of numThreads less
+    /// than 1 means to use the number of hardware threads.
     static void filterLowpass(TimeSeriesTable& table,
-            double cutoffFreq, bool padData = false);
+            double cutoffFreq, bool padData = false, int numThreads = 1);
+
+    /// Lowpass filter the data in a TimeSeriesTable with a non-recursive
+    /// (FIR) filter of the provided order (see Signal::LowpassFIR()). The
+    /// table must have at least 2 * order rows. The arguments padData and
+    /// numThreads have the same meaning as for filterLowpass().
+    static void filterLowpassFIR(TimeSeriesTable& table, int order,
+            double cutoffFreq, bool padData = false, int numThreads = 1);
+
+    /// Smooth the data in a TimeSeriesTable with a generalized,
+    /// cross-validatory smoothing spline of the provided (odd) degree, whose
+    /// smoothing parameter is chosen to match the provided cutoff frequency
+    /// (see Signal::SmoothSpline()). The columns are smoothed in parallel on
+    /// numThreads threads, as in filterLowpass().
+    static void smoothSpline(TimeSeriesTable& table, int degree,
+            double cutoffFreq, int numThreads = 1);
 
     /// Pad each column by the number of rows specified. The padded data is
     /// obtained by reflecting and negating the data in the table.
@@ -27,6 +27,7 @@
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -861,6 +862,82 @@ TEST_CASE("TableUtilities::filterLowpass") {
     }
 }
 
+TEST_CASE("TableUtilities batch filters") {
+    // Use a number of columns that is not a multiple of the block size of the
+    // batch filters, and enough data for the filters to use multiple threads.
+    // The sampling interval is exactly representable so that the table is not
+    // resampled.
+    const int numRows = 2000;
+    const int numColumns = 37;
+    const double dt = 1.0 / 128.0;
+    std::vector<double> time(numRows);
+    for (int irow = 0; irow < numRows; ++irow) time[irow] = irow * dt;
+    TimeSeriesTable table(time);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        table.appendColumn(std::to_string(icol),
+                SimTK::Test::randVector(numRows));
+    }
+
+    // Filter each column of the original table with the single-signal
+    // filters.
+    const auto filterColumns = [&](
+            const std::function<void(const double*, double*)>& filter) {
+        SimTK::Matrix expected(numRows, numColumns);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            SimTK::Vector column = table.getDependentColumnAtIndex(icol);
+            SimTK::Vector filtered(numRows);
+            filter(column.getContiguousScalarData(),
+                    filtered.updContiguousScalarData());
+            expected.updCol(icol) = filtered;
+        }
+        return expected;
+    };
+    const auto checkEqual = [&](const TimeSeriesTable& actual,
+            const SimTK::Matrix& expected) {
+        REQUIRE((int)actual.getNumRows() == numRows);
+        REQUIRE((int)actual.getNumColumns() == numColumns);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            for (int irow = 0; irow < numRows; ++irow) {
+                CHECK(actual.getMatrix()(irow, icol) == expected(irow, icol));
+            }
+        }
+    };
+
+    const SimTK::Matrix expectedIIR = filterColumns(
+            [&](const double* signal, double* filtered) {
+                Signal::LowpassIIR(dt, 6.0, numRows, signal, filtered);
+            });
+    const SimTK::Matrix expectedFIR = filterColumns(
+            [&](const double* signal, double* filtered) {
+                Signal::LowpassFIR(20, dt, 6.0, numRows,
+                        const_cast<double*>(signal), filtered);
+            });
+    const SimTK::Matrix expectedSpline = filterColumns(
+            [&](const double* signal, double* filtered) {
+                Signal::SmoothSpline(5, dt, 6.0, numRows, time.data(),
+                        const_cast<double*>(signal), filtered);
+            });
+
+    // The results do not depend on the number of threads.
+    for (int numThreads : {1, 3, -1}) {
+        TimeSeriesTable iir(table);
+        TableUtilities::filterLowpass(iir, 6.0, false, numThreads);
+        checkEqual(iir, expectedIIR);
+
+        TimeSeriesTable fir(table);
+        TableUtilities::filterLowpassFIR(fir, 20, 6.0, false, numThreads);
+        checkEqual(fir, expectedFIR);
+
+        TimeSeriesTable spline(table);
+        TableUtilities::smoothSpline(spline, 5, 6.0, numThreads);
+        checkEqual(spline, expectedSpline);
+    }
+
+    TimeSeriesTable tooShort(table);
+    CHECK_THROWS_AS(TableUtilities::filterLowpassFIR(tooShort, 1001, 6.0),
+            Exception);
+}
+
 TEST_CASE("TableUtilities::pad") {
     Storage sto("test.sto");
     TimeSeriesTable paddedTable = sto.exportToTable();
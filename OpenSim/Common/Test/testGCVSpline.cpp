@@ -82,6 +82,37 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // Fit enough columns for the splines to be fit in parallel, and
+        // check the batched evaluation against evaluating each spline.
+        const int numRows = 301;
+        const int numColumns = 40;
+        std::vector<double> time(numRows);
+        for (int i = 0; i < numRows; ++i) time[i] = i / (numRows - 1.0);
+        TimeSeriesTable table(time);
+        for (int j = 0; j < numColumns; ++j) {
+            SimTK::Vector column(numRows);
+            for (int i = 0; i < numRows; ++i) {
+                column[i] = sin((j + 1) * omega * time[i]);
+            }
+            table.appendColumn("col" + std::to_string(j), column);
+        }
+        GCVSplineSet set(table);
+        GCVSplineSet copy(set);
+        SimTK::Vector values, firstDerivs, secondDerivs;
+        for (double x : {0.0, 0.1234, 0.5, 0.999, 1.0}) {
+            set.calcValuesAndDerivatives(x, values, firstDerivs, secondDerivs);
+            ASSERT(values.size() == numColumns);
+            for (int j = 0; j < numColumns; ++j) {
+                ASSERT(values[j] == set.evaluate(j, 0, x));
+                ASSERT(firstDerivs[j] == set.evaluate(j, 1, x));
+                ASSERT(secondDerivs[j] == set.evaluate(j, 2, x));
+                ASSERT(values[j] == copy.evaluate(j, 0, x));
+                ASSERT(secondDerivs[j] == copy.evaluate(j, 2, x));
+            }
+        }
+        cout << "GCVSplineSet successfully evaluated splines in a batch."
+             << endl;
     }
     catch(const Exception& e) {
         e.print(cerr);
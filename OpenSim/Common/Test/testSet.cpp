@@ -0,0 +1,188 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  testSet.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/Storage.h>
+
+#include <SimTKcommon/Testing.h>
+
+#include <memory>
+
+using namespace OpenSim;
+
+// The index of the first element named `name`, searching from startIndex
+// and wrapping around, as documented by ArrayPtrs::getIndex().
+int findIndexLinearly(const FunctionSet& set, const std::string& name,
+        int startIndex = 0) {
+    const int size = set.getSize();
+    if (startIndex < 0 || startIndex >= size) startIndex = 0;
+    for (int i = 0; i < size; ++i) {
+        const int index = (startIndex + i) % size;
+        if (set.get(index).getName() == name) return index;
+    }
+    return -1;
+}
+
+void testNameLookup() {
+    FunctionSet set;
+    const int numFunctions = 300;
+    for (int i = 0; i < numFunctions; ++i) {
+        auto* function = new Constant(i);
+        function->setName("f" + std::to_string(i));
+        set.adoptAndAppend(function);
+    }
+    for (int i = 0; i < numFunctions; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        SimTK_TEST(set.getIndex(name) == i);
+        SimTK_TEST(set.contains(name));
+        SimTK_TEST(&set.get(name) == &set.get(i));
+    }
+    SimTK_TEST(set.getIndex("missing") == -1);
+    SimTK_TEST(!set.contains("missing"));
+    SimTK_TEST_MUST_THROW_EXC(set.get("missing"), Exception);
+
+    // Renaming an element updates the lookup.
+    set.get(5).setName("renamed");
+    SimTK_TEST(!set.contains("f5"));
+    SimTK_TEST(set.getIndex("renamed") == 5);
+
+    // Removing and inserting elements shifts the indices.
+    set.remove(0);
+    SimTK_TEST(set.getIndex("f1") == 0);
+    SimTK_TEST(set.getIndex("renamed") == 4);
+    SimTK_TEST(!set.contains("f0"));
+    auto* inserted = new Constant(-1);
+    inserted->setName("inserted");
+    set.insert(0, inserted);
+    SimTK_TEST(set.getIndex("inserted") == 0);
+    SimTK_TEST(set.getIndex("f1") == 1);
+
+    // Copies have their own lookup.
+    FunctionSet copy(set);
+    copy.get(1).setName("f1_copy");
+    SimTK_TEST(copy.getIndex("f1_copy") == 1);
+    SimTK_TEST(set.getIndex("f1") == 1);
+    SimTK_TEST(!set.contains("f1_copy"));
+}
+
+void testAppendAfterLookup() {
+    // Appending keeps the lookup up to date without rebuilding it, including
+    // when the appended element has the name of an earlier element.
+    FunctionSet set;
+    for (int i = 0; i < 100; ++i) {
+        auto* function = new Constant(i);
+        function->setName("f" + std::to_string(i % 40));
+        set.adoptAndAppend(function);
+        for (int j = 0; j <= i; ++j) {
+            const std::string name = "f" + std::to_string(j % 40);
+            SimTK_TEST(set.getIndex(name) == j % 40);
+            SimTK_TEST(set.getIndex(name, j) ==
+                       findIndexLinearly(set, name, j));
+        }
+    }
+    // Renaming an appended element updates the lookup.
+    set.get(99).setName("renamed");
+    SimTK_TEST(set.getIndex("renamed") == 99);
+}
+
+void testDuplicateNames() {
+    FunctionSet set;
+    // Enough elements that the array uses its name index.
+    std::vector<std::string> names;
+    for (int i = 0; i < 4; ++i) {
+        names.insert(names.end(), {"a", "b", "a", "c", "b", "a"});
+    }
+    for (const auto& name : names) {
+        auto* function = new Constant(0);
+        function->setName(name);
+        set.adoptAndAppend(function);
+    }
+    for (const std::string name : {"a", "b", "c", "d"}) {
+        for (int start = -1; start <= (int)names.size(); ++start) {
+            SimTK_TEST(set.getIndex(name, start) ==
+                       findIndexLinearly(set, name, start));
+        }
+    }
+}
+
+void testStorageNames() {
+    ArrayPtrs<Storage> storages;
+    for (int i = 0; i < 20; ++i) {
+        auto* storage = new Storage();
+        storage->setName("storage" + std::to_string(i));
+        storages.append(storage);
+    }
+    SimTK_TEST(storages.getIndex("storage3") == 3);
+    storages.get(3)->setName("renamed");
+    SimTK_TEST(storages.getIndex("storage3") == -1);
+    SimTK_TEST(storages.getIndex("renamed") == 3);
+}
+
+void testSharedElements() {
+    // Arrays that do not own their elements can share them with a Set; a
+    // rename must update the index of every array holding the element.
+    FunctionSet set;
+    ArrayPtrs<Function> view;
+    view.setMemoryOwner(false);
+    for (int i = 0; i < 20; ++i) {
+        auto* function = new Constant(i);
+        function->setName("f" + std::to_string(i));
+        set.adoptAndAppend(function);
+        view.append(function);
+    }
+    SimTK_TEST(set.getIndex("f2") == 2);
+    SimTK_TEST(view.getIndex("f2") == 2);
+    set.get(2).setName("renamed");
+    SimTK_TEST(set.getIndex("renamed") == 2);
+    SimTK_TEST(view.getIndex("renamed") == 2);
+    SimTK_TEST(view.getIndex("f2") == -1);
+
+    // Assigning to an element renames it.
+    set.get(3) = set.get(4);
+    SimTK_TEST(set.getIndex("f4") == 3);
+    SimTK_TEST(view.getIndex("f4") == 3);
+
+    // Copies of an element are not indexed by the original's containers.
+    std::unique_ptr<Function> copy(set.get(0).clone());
+    copy->setName("copy");
+    SimTK_TEST(set.getIndex("f0") == 0);
+    SimTK_TEST(!set.contains("copy"));
+
+    // An element removed from the view no longer affects its index.
+    view.remove(0);
+    SimTK_TEST(view.getIndex("f1") == 0);
+    set.get(0).setName("f1");
+    SimTK_TEST(view.getIndex("f1") == 0);
+    SimTK_TEST(set.getIndex("f1") == 0);
+}
+
+int main() {
+    SimTK_START_TEST("testSet");
+        SimTK_SUBTEST(testNameLookup);
+        SimTK_SUBTEST(testAppendAfterLookup);
+        SimTK_SUBTEST(testDuplicateNames);
+        SimTK_SUBTEST(testStorageNames);
+        SimTK_SUBTEST(testSharedElements);
+    SimTK_END_TEST();
+}
@@ -24,6 +24,7 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Signal.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -170,6 +171,82 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageColumnOperations() {
+    // A storage with uniformly sampled sinusoids in each column.
+    const int numRows = 200;
+    const int numColumns = 5;
+    const double dt = 0.01;
+    Storage storage;
+    Array<std::string> labels;
+    labels.append("time");
+    for (int j = 0; j < numColumns; ++j) labels.append("c" + std::to_string(j));
+    storage.setColumnLabels(labels);
+    for (int i = 0; i < numRows; ++i) {
+        SimTK::Vector row(numColumns);
+        for (int j = 0; j < numColumns; ++j) {
+            row[j] = std::sin((j + 1) * i * dt) + 0.1 * std::cos(40 * i * dt);
+        }
+        storage.append(i * dt, row);
+    }
+
+    // The exported table matches the state vectors.
+    const TimeSeriesTable table = storage.exportToTable();
+    SimTK_TEST((int)table.getNumRows() == numRows);
+    SimTK_TEST((int)table.getNumColumns() == numColumns);
+    SimTK_TEST(table.getColumnLabel(2) == "c2");
+    SimTK_TEST(table.getTableMetaData<std::string>("nRows") ==
+               std::to_string(numRows));
+    for (int i = 0; i < numRows; i += 17) {
+        SimTK_TEST_EQ(table.getIndependentColumn()[i],
+                storage.getStateVector(i)->getTime());
+        for (int j = 0; j < numColumns; ++j) {
+            SimTK_TEST_EQ(table.getMatrix()(i, j),
+                    storage.getStateVector(i)->getData()[j]);
+        }
+    }
+
+    // findIndex() returns the last index at or before the given time.
+    for (double time : {-1.0, 0.0, 0.005, 0.5, 0.501, 1.99, 5.0}) {
+        int expected = 0;
+        for (int i = 0; i < numRows; ++i) {
+            if (storage.getStateVector(i)->getTime() <= time) expected = i;
+        }
+        SimTK_TEST(storage.findIndex(time) == expected);
+    }
+
+    // Filtering operates on each column independently.
+    Storage filtered(storage);
+    filtered.lowpassIIR(6.0);
+    for (int j = 0; j < numColumns; ++j) {
+        Array<double> column;
+        storage.getDataColumn(j, column);
+        std::vector<double> expected(numRows);
+        Signal::LowpassIIR(dt, 6.0, numRows, &column[0], expected.data());
+        Array<double> actual;
+        filtered.getDataColumn(j, actual);
+        for (int i = 0; i < numRows; ++i) {
+            SimTK_TEST_EQ(actual[i], expected[i]);
+        }
+    }
+
+    // Padding reflects each column.
+    const int padSize = 10;
+    Storage padded(storage);
+    padded.pad(padSize);
+    SimTK_TEST(padded.getSize() == numRows + 2 * padSize);
+    for (int j = 0; j < numColumns; ++j) {
+        Array<double> column;
+        storage.getDataColumn(j, column);
+        Signal::Pad(padSize, column);
+        Array<double> actual;
+        padded.getDataColumn(j, actual);
+        SimTK_TEST(actual.getSize() == column.getSize());
+        for (int i = 0; i < actual.getSize(); ++i) {
+            SimTK_TEST_EQ(actual[i], column[i]);
+        }
+    }
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +271,7 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+        SimTK_SUBTEST(testStorageColumnOperations);
     SimTK_END_TEST();
 }
 
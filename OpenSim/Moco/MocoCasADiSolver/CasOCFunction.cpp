@@ -92,7 +92,8 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
         }
 
         // Evaluate the function.
-        std::vector<casadi::DM> out = this->eval(in);
+        // Bypass eval() so that sparsity detection is not profiled.
+        std::vector<casadi::DM> out = this->evalImpl(in);
 
         // Create output.
         y = casadi::DM::veccat(out);
@@ -104,6 +105,15 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
             x0s, (int)this->nnz_out(), function);
 }
 
+VectorDM Function::eval(const VectorDM& args) const {
+    if (!m_profilingEnabled) return evalImpl(args);
+    const long long start = SimTK::realTimeInNs();
+    VectorDM out = evalImpl(args);
+    m_evaluationTimeInNs += SimTK::realTimeInNs() - start;
+    ++m_numEvaluations;
+    return out;
+}
+
 void Function::constructFunction(const Problem* casProblem,
         const std::string& name, const std::string& finiteDiffScheme,
         std::shared_ptr<const std::vector<VariablesDM>>
@@ -134,7 +144,7 @@ casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
     }
 }
 
-VectorDM PathConstraint::eval(const VectorDM& args) const {
+VectorDM PathConstraint::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(sparsity_out(0))};
@@ -142,7 +152,7 @@ VectorDM PathConstraint::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM CostIntegrand::eval(const VectorDM& args) const {
+VectorDM CostIntegrand::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -150,7 +160,7 @@ VectorDM CostIntegrand::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM EndpointConstraintIntegrand::eval(const VectorDM& args) const {
+VectorDM EndpointConstraintIntegrand::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
                                    args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -188,7 +198,7 @@ casadi::Sparsity Endpoint::get_sparsity_in(casadi_int i) {
         return casadi::Sparsity(0, 0);
     }
 }
-VectorDM Cost::eval(const VectorDM& args) const {
+VectorDM Cost::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -196,7 +206,7 @@ VectorDM Cost::eval(const VectorDM& args) const {
     m_casProblem->calcCost(m_index, input, out.at(0));
     return out;
 }
-VectorDM EndpointConstraint::eval(const VectorDM& args) const {
+VectorDM EndpointConstraint::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -230,7 +240,7 @@ casadi::Sparsity MultibodySystemExplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemExplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -283,7 +293,7 @@ casadi::DM VelocityCorrection::getSubsetPoint(
             fullPoint.at(slacks)(Slice(), itime), fullPoint.at(parameters)});
 }
 
-VectorDM VelocityCorrection::eval(const VectorDM& args) const {
+VectorDM VelocityCorrection::evalImpl(const VectorDM& args) const {
     VectorDM out{casadi::DM(sparsity_out(0))};
     m_casProblem->calcVelocityCorrection(
             args.at(0).scalar(), args.at(1), args.at(2), args.at(3), out[0]);
@@ -315,7 +325,7 @@ casadi::Sparsity MultibodySystemImplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemImplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
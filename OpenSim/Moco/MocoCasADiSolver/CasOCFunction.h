@@ -22,6 +22,8 @@
 
 #include <OpenSim/Common/Exception.h>
 
+#include <atomic>
+
 namespace CasOC {
 
 class Problem;
@@ -63,7 +65,30 @@ public:
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
 
+    /// This records the evaluation count and wall time (if profiling is
+    /// enabled) and then invokes evalImpl().
+    VectorDM eval(const VectorDM& args) const override final;
+
+    /// @name Profiling
+    /// If profiling is enabled, each evaluation of this function (including
+    /// the evaluations CasADi performs to compute finite differences) is
+    /// counted and timed. The counters are atomic, as CasADi may evaluate
+    /// this function from multiple threads.
+    /// @{
+    void setProfilingEnabled(bool tf) { m_profilingEnabled = tf; }
+    bool getProfilingEnabled() const { return m_profilingEnabled; }
+    long long getNumEvaluations() const { return m_numEvaluations; }
+    /// Total wall time spent in eval(), summed over all threads.
+    long long getEvaluationTimeInNs() const { return m_evaluationTimeInNs; }
+    void resetProfilingCounters() {
+        m_numEvaluations = 0;
+        m_evaluationTimeInNs = 0;
+    }
+    /// @}
+
 protected:
+    virtual VectorDM evalImpl(const VectorDM& args) const = 0;
+
     const Problem* m_casProblem;
 
 private:
@@ -91,6 +116,10 @@ private:
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+
+    bool m_profilingEnabled = false;
+    mutable std::atomic<long long> m_numEvaluations{0};
+    mutable std::atomic<long long> m_evaluationTimeInNs{0};
 };
 
 class PathConstraint : public Function {
@@ -117,7 +146,7 @@ public:
         } else
             return casadi::Sparsity(0, 0);
     }
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 protected:
     int m_index = -1;
@@ -154,12 +183,12 @@ protected:
 
 class CostIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 class EndpointConstraintIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function takes initial states/controls, final states/controls, and an
@@ -241,13 +270,13 @@ protected:
 /// This invokes CasOC::Problem::calcCost().
 class Cost : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This invokes CasOC::Problem::calcEndpointConstraint().
 class EndpointConstraint : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 };
 
@@ -267,7 +296,7 @@ public:
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -293,7 +322,7 @@ public:
     }
     casadi::Sparsity get_sparsity_in(casadi_int i) override final;
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
     casadi::DM getSubsetPoint(const VariablesDM& fullPoint) const override;
 };
 
@@ -310,7 +339,7 @@ class MultibodySystemImplicit : public Function {
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 } // namespace CasOC
@@ -70,10 +70,21 @@ struct Iterate {
 /// This struct is used to return a solution to a problem. Use `stats`
 /// to check if the problem converged.
 using ObjectiveBreakdown = std::vector<std::pair<std::string, double>>;
+/// The number of calls to, and the wall time spent in, a part of the
+/// optimization (an NLP oracle function, the optimizer itself, or a
+/// CasOC::Function).
+struct ProfileEntry {
+    std::string name;
+    long long num_calls = 0;
+    long long wall_time_ns = 0;
+};
+using Profile = std::vector<ProfileEntry>;
 struct Solution : public Iterate {
     casadi::Dict stats;
     double objective;
     ObjectiveBreakdown objective_breakdown;
+    /// This is empty unless Solver::setProfileCallbacks() was enabled.
+    Profile profile;
 };
 
 } // namespace CasOC
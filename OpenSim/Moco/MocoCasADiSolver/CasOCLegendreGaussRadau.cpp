@@ -0,0 +1,162 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCLegendreGaussRadau.cpp                                  *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCLegendreGaussRadau.h"
+
+using casadi::DM;
+using casadi::MX;
+using casadi::Slice;
+
+namespace CasOC {
+
+void LegendreGaussRadau::calcPointsAndWeights(int degree,
+        std::vector<double>& points, std::vector<double>& weights) {
+    OPENSIM_THROW_IF(degree < 1, OpenSim::Exception,
+            "Expected degree >= 1 but got {}.", degree);
+    const int N = degree;
+    points.resize(N);
+    weights.resize(N);
+
+    // The LGR points are -1 and the roots of (P_{N-1} + P_N) / (1 + x), where
+    // P_k is the Legendre polynomial of degree k. We find the roots using
+    // Newton's method, starting from the Chebyshev-Gauss-Radau points.
+    // P[k] holds P_k evaluated at the current point.
+    std::vector<double> P(N + 1);
+    auto evalLegendre = [&P, N](double x) {
+        P[0] = 1;
+        if (N > 0) P[1] = x;
+        for (int k = 2; k <= N; ++k) {
+            P[k] = ((2 * k - 1) * x * P[k - 1] - (k - 1) * P[k - 2]) / k;
+        }
+    };
+    points[0] = -1;
+    for (int i = 1; i < N; ++i) {
+        double x = -std::cos(2 * SimTK::Pi * i / (2 * N - 1));
+        for (int iter = 0; iter < 100; ++iter) {
+            evalLegendre(x);
+            const double dx = (1 - x) / N * (P[N - 1] + P[N]) /
+                              (P[N - 1] - P[N]);
+            x -= dx;
+            if (std::abs(dx) < SimTK::Eps) break;
+        }
+        points[i] = x;
+    }
+
+    weights[0] = 2.0 / (N * N);
+    for (int i = 1; i < N; ++i) {
+        evalLegendre(points[i]);
+        weights[i] = (1 - points[i]) / std::pow(N * P[N - 1], 2);
+    }
+}
+
+LegendreGaussRadau::LegendreGaussRadau(
+        const Solver& solver, const Problem& problem)
+        : Transcription(solver, problem),
+          m_degree(solver.getInterpolatingPolynomialDegree()) {
+    OPENSIM_THROW_IF(problem.getNumKinematicConstraintEquations() != 0,
+            OpenSim::Exception,
+            "Kinematic constraints are not supported with "
+            "Legendre-Gauss-Radau transcription.");
+
+    calcPointsAndWeights(
+            m_degree, m_legendreGaussRadauPoints, m_quadratureWeights);
+
+    // Differentiation matrix, using barycentric weights of the support points
+    // (the LGR points and the end of the interval, +1).
+    const int N = m_degree;
+    std::vector<double> tau(m_legendreGaussRadauPoints);
+    tau.push_back(1.0);
+    std::vector<double> baryWeights(N + 1, 1.0);
+    for (int j = 0; j <= N; ++j) {
+        for (int k = 0; k <= N; ++k) {
+            if (k != j) baryWeights[j] /= (tau[j] - tau[k]);
+        }
+    }
+    m_differentiationMatrix = DM::zeros(N, N + 1);
+    for (int i = 0; i < N; ++i) {
+        double diagonal = 0;
+        for (int j = 0; j <= N; ++j) {
+            if (j == i) continue;
+            const double value =
+                    baryWeights[j] / baryWeights[i] / (tau[i] - tau[j]);
+            m_differentiationMatrix(i, j) = value;
+            diagonal -= value;
+        }
+        m_differentiationMatrix(i, i) = diagonal;
+    }
+
+    // The grid contains the N LGR points of each mesh interval, followed by
+    // the final mesh point.
+    const auto& mesh = m_solver.getMesh();
+    const int numMeshIntervals = (int)mesh.size() - 1;
+    DM grid = DM::zeros(1, N * numMeshIntervals + 1);
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const double h = mesh[imesh + 1] - mesh[imesh];
+        for (int i = 0; i < N; ++i) {
+            grid(N * imesh + i) =
+                    mesh[imesh] + 0.5 * h * (m_legendreGaussRadauPoints[i] + 1);
+        }
+    }
+    grid(N * numMeshIntervals) = mesh.back();
+
+    createVariablesAndSetBounds(grid, N * m_problem.getNumStates());
+}
+
+DM LegendreGaussRadau::createQuadratureCoefficientsImpl() const {
+    const int N = m_degree;
+    const DM mesh(m_solver.getMesh());
+    // The final grid point has zero weight.
+    DM quadCoeffs(m_numGridPoints, 1);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const double h = (mesh(imesh + 1) - mesh(imesh)).scalar();
+        for (int i = 0; i < N; ++i) {
+            quadCoeffs(N * imesh + i) = 0.5 * h * m_quadratureWeights[i];
+        }
+    }
+    return quadCoeffs;
+}
+
+DM LegendreGaussRadau::createMeshIndicesImpl() const {
+    DM indices = DM::zeros(1, m_numGridPoints);
+    for (int i = 0; i < m_numGridPoints; i += m_degree) { indices(i) = 1; }
+    return indices;
+}
+
+void LegendreGaussRadau::calcDefectsImpl(const casadi::MX& x,
+        const casadi::MX& xdot, casadi::MX& defects) const {
+    // For more information, see doxygen documentation for the class.
+    const int N = m_degree;
+    const int NS = m_problem.getNumStates();
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int igrid = N * imesh;
+        const auto h = m_times(igrid + N) - m_times(igrid);
+        // States at the LGR points and the end of the mesh interval.
+        const auto x_i = x(Slice(), Slice(igrid, igrid + N + 1));
+        const auto xdot_i = xdot(Slice(), Slice(igrid, igrid + N));
+
+        // The polynomial's derivative is with respect to tau in [-1, 1];
+        // the factor h / 2 converts the state derivatives to this domain.
+        const auto residual =
+                MX::mtimes(x_i, m_differentiationMatrix.T()) - 0.5 * h * xdot_i;
+        // Stack the residuals at each LGR point, one point at a time.
+        for (int i = 0; i < N; ++i) {
+            defects(Slice(i * NS, (i + 1) * NS), imesh) = residual(Slice(), i);
+        }
+    }
+}
+
+} // namespace CasOC
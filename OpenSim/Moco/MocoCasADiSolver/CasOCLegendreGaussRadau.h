@@ -0,0 +1,77 @@
+#ifndef OPENSIM_CASOCLEGENDREGAUSSRADAU_H
+#define OPENSIM_CASOCLEGENDREGAUSSRADAU_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCLegendreGaussRadau.h                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTranscription.h"
+
+namespace CasOC {
+
+/// Enforce the differential equations in the problem using Legendre-Gauss-
+/// Radau (LGR) orthogonal collocation, a pseudospectral method. Within each
+/// mesh interval, the states are approximated by a Lagrange polynomial of
+/// degree d (Solver::setInterpolatingPolynomialDegree()) that interpolates
+/// the states at the d LGR points of the interval and at the end of the
+/// interval. The first LGR point coincides with the start of the mesh
+/// interval. The integral in the objective function is approximated by
+/// Gauss-Radau quadrature, which is exact for polynomials of degree 2d - 2.
+///
+/// Defect constraints.
+/// -------------------
+/// For each state variable, there are d defect constraints per mesh
+/// interval: the derivative of the interpolating polynomial must equal the
+/// state derivative at each of the d LGR points.
+///
+/// Kinematic constraints and path constraints.
+/// -------------------------------------------
+/// Path constraints are enforced at the mesh points, or at all grid points if
+/// path constraint midpoints are enforced (see
+/// Solver::setEnforcePathConstraintMidpoints()). Kinematic constraints are
+/// not supported.
+///
+/// Reference: Garg, D., Patterson, M., Hager, W. W., Rao, A. V., Benson,
+/// D. A., & Huntington, G. T. (2010). A unified framework for the numerical
+/// solution of optimal control problems using pseudospectral methods.
+/// Automatica, 46(11), 1843-1851.
+class LegendreGaussRadau : public Transcription {
+public:
+    LegendreGaussRadau(const Solver& solver, const Problem& problem);
+
+    /// Compute the d LGR points on [-1, 1) (the first point is -1) and the
+    /// corresponding quadrature weights.
+    static void calcPointsAndWeights(
+            int degree, std::vector<double>& points, std::vector<double>& weights);
+
+private:
+    casadi::DM createQuadratureCoefficientsImpl() const override;
+    casadi::DM createMeshIndicesImpl() const override;
+    void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
+            casadi::MX& defects) const override;
+
+    int m_degree;
+    std::vector<double> m_legendreGaussRadauPoints;
+    std::vector<double> m_quadratureWeights;
+    /// The d x (d + 1) matrix that, applied to the states at the d LGR points
+    /// and at the end of a mesh interval, gives the derivative of the
+    /// interpolating polynomial at the d LGR points (in the [-1, 1] domain).
+    casadi::DM m_differentiationMatrix;
+};
+
+} // namespace CasOC
+
+#endif // OPENSIM_CASOCLEGENDREGAUSSRADAU_H
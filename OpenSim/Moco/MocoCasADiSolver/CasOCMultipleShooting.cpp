@@ -0,0 +1,125 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCMultipleShooting.cpp                                    *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCMultipleShooting.h"
+
+using casadi::DM;
+using casadi::MX;
+using casadi::MXVector;
+using casadi::Slice;
+
+namespace CasOC {
+
+DM MultipleShooting::createQuadratureCoefficientsImpl() const {
+
+    // As with trapezoidal transcription, grid points and mesh points are
+    // synonymous.
+    const int numMeshPoints = m_numGridPoints;
+    const DM meshIntervals = m_grid(Slice(1, numMeshPoints)) -
+                             m_grid(Slice(0, numMeshPoints - 1));
+    DM quadCoeffs(numMeshPoints, 1);
+    quadCoeffs(Slice(0, numMeshPoints - 1)) = 0.5 * meshIntervals;
+    quadCoeffs(Slice(1, numMeshPoints)) += 0.5 * meshIntervals;
+
+    return quadCoeffs;
+}
+
+DM MultipleShooting::createMeshIndicesImpl() const {
+    return DM::ones(1, m_numGridPoints);
+}
+
+casadi::Function MultipleShooting::createSegmentFunction() const {
+    const int NQ = m_problem.getNumCoordinates();
+    const int NU = m_problem.getNumSpeeds();
+    const int NS = m_problem.getNumStates();
+    const int NC = m_problem.getNumControls();
+    const int NP = m_problem.getNumParameters();
+    const int numSteps = m_solver.getMultipleShootingNumSteps();
+
+    const MX time = MX::sym("time");
+    const MX duration = MX::sym("duration");
+    const MX initialStates = MX::sym("initial_states", NS);
+    const MX initialStateDerivatives =
+            MX::sym("initial_state_derivatives", NS);
+    const MX initialControls = MX::sym("initial_controls", NC);
+    const MX finalControls = MX::sym("final_controls", NC);
+    const MX params = MX::sym("parameters", NP);
+
+    // Multiple shooting does not support kinematic constraints or implicit
+    // auxiliary dynamics, so these inputs are empty.
+    const MX multipliers = MX::zeros(m_problem.getNumMultipliers(), 1);
+    const MX derivatives = MX::zeros(m_problem.getNumDerivatives(), 1);
+    const casadi::Function& multibodySystem =
+            m_problem.getMultibodySystemIgnoringConstraints();
+    auto calcStateDerivatives = [&](const MX& t, const MX& x,
+                                        double fraction) {
+        const MX c =
+                (1.0 - fraction) * initialControls + fraction * finalControls;
+        const MXVector out = multibodySystem(
+                MXVector{t, x, c, multipliers, derivatives, params});
+        // qdot = u, followed by udot and zdot.
+        return MX::vertcat({x(Slice(NQ, NQ + NU)), out.at(0), out.at(1)});
+    };
+
+    const MX h = duration / numSteps;
+    MX x = initialStates;
+    for (int istep = 0; istep < numSteps; ++istep) {
+        const MX t = time + istep * h;
+        const double f0 = istep / (double)numSteps;
+        const double fmid = (istep + 0.5) / numSteps;
+        const double f1 = (istep + 1.0) / numSteps;
+        const MX k1 = istep == 0 ? initialStateDerivatives
+                                 : calcStateDerivatives(t, x, f0);
+        const MX k2 = calcStateDerivatives(t + 0.5 * h, x + 0.5 * h * k1, fmid);
+        const MX k3 = calcStateDerivatives(t + 0.5 * h, x + 0.5 * h * k2, fmid);
+        const MX k4 = calcStateDerivatives(t + h, x + h * k3, f1);
+        x = x + (h / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+    }
+
+    return casadi::Function("shooting_segment",
+            {time, duration, initialStates, initialStateDerivatives,
+                    initialControls, finalControls, params},
+            {x},
+            {"time", "duration", "initial_states", "initial_state_derivatives",
+                    "initial_controls", "final_controls", "parameters"},
+            {"final_states"});
+}
+
+void MultipleShooting::calcDefectsImpl(
+        const casadi::MX& x, const casadi::MX& xdot, casadi::MX& defects) const {
+    const int N = m_numMeshIntervals;
+    const auto& vars = getUnscaledVariables();
+    const auto parallelism = m_solver.getParallelism();
+    const casadi::Function segments = createSegmentFunction().map(
+            N, parallelism.first, parallelism.second);
+
+    const Slice segmentStart(0, N);
+    const Slice segmentEnd(1, N + 1);
+    const MX& controlsTraj = vars.at(controls);
+    MXVector out;
+    segments.call({m_times(segmentStart),
+                          m_times(segmentEnd) - m_times(segmentStart),
+                          x(Slice(), segmentStart), xdot(Slice(), segmentStart),
+                          controlsTraj(Slice(), segmentStart),
+                          controlsTraj(Slice(), segmentEnd),
+                          MX::repmat(vars.at(parameters), 1, N)},
+            out);
+
+    defects = x(Slice(), segmentEnd) - out.at(0);
+}
+
+} // namespace CasOC
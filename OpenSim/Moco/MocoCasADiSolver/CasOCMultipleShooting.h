@@ -0,0 +1,82 @@
+#ifndef OPENSIM_CASOCMULTIPLESHOOTING_H
+#define OPENSIM_CASOCMULTIPLESHOOTING_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCMultipleShooting.h                                           *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTranscription.h"
+
+namespace CasOC {
+
+/// Enforce the differential equations in the problem using direct multiple
+/// shooting. Each mesh interval is a shooting segment: the states at the mesh
+/// points are variables in the optimization problem, and each segment's
+/// defect is the difference between the states at the end of the segment and
+/// the states obtained by integrating the dynamics across the segment from
+/// the states at the start of the segment. The integral in the objective
+/// function is approximated by trapezoidal quadrature.
+///
+/// Integration of the segments.
+/// ----------------------------
+/// The dynamics are integrated using a fixed number of classical fourth-order
+/// Runge-Kutta steps per segment (Solver::setMultipleShootingNumSteps()).
+/// Controls are linearly interpolated between the mesh points. The first
+/// stage of the first step reuses the state derivatives that are already
+/// computed at the mesh points. The segments are independent of each other
+/// and are therefore evaluated with the parallelism given to
+/// Solver::setParallelism().
+///
+/// Limitations.
+/// ------------
+/// Multiple shooting requires explicit multibody dynamics, and does not
+/// support kinematic constraints or auxiliary dynamics in implicit form.
+class MultipleShooting : public Transcription {
+public:
+    MultipleShooting(const Solver& solver, const Problem& problem)
+            : Transcription(solver, problem) {
+        OPENSIM_THROW_IF(problem.isDynamicsModeImplicit(), OpenSim::Exception,
+                "Multiple shooting transcription requires explicit "
+                "multibody dynamics.");
+        OPENSIM_THROW_IF(problem.getNumKinematicConstraintEquations() != 0,
+                OpenSim::Exception,
+                "Kinematic constraints are not supported with multiple "
+                "shooting transcription.");
+        OPENSIM_THROW_IF(problem.getNumAuxiliaryResidualEquations() != 0,
+                OpenSim::Exception,
+                "Auxiliary dynamics in implicit form are not supported with "
+                "multiple shooting transcription.");
+        createVariablesAndSetBounds(m_solver.getMesh(),
+                m_problem.getNumStates());
+    }
+
+private:
+    casadi::DM createQuadratureCoefficientsImpl() const override;
+    casadi::DM createMeshIndicesImpl() const override;
+    void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
+            casadi::MX& defects) const override;
+
+    /// Create a function that integrates the dynamics across a single
+    /// segment. The inputs are the initial time, the segment duration, the
+    /// initial states and state derivatives, the controls at the start and
+    /// end of the segment, and the parameters. The output is the states at the
+    /// end of the segment.
+    casadi::Function createSegmentFunction() const;
+};
+
+} // namespace CasOC
+
+#endif // OPENSIM_CASOCMULTIPLESHOOTING_H
@@ -381,7 +381,8 @@ public:
 
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
-                    pointsForSparsityDetection) const {
+                    pointsForSparsityDetection,
+            bool profileFunctions = false) const {
         auto* mutThis = const_cast<Problem*>(this);
 
         {
@@ -463,6 +464,26 @@ public:
                     "velocity_correction", finiteDiffScheme,
                     pointsForSparsityDetection);
         }
+
+        for (Function* function : getFunctions()) {
+            function->setProfilingEnabled(profileFunctions);
+            function->resetProfilingCounters();
+        }
+    }
+
+    /// Number of evaluations of, and wall time spent in, each function that
+    /// has been constructed by initialize(). The counts are only non-zero if
+    /// initialize() was invoked with `profileFunctions` set to true.
+    Profile createFunctionProfile() const {
+        Profile profile;
+        for (const Function* function : getFunctions()) {
+            ProfileEntry entry;
+            entry.name = function->name();
+            entry.num_calls = function->getNumEvaluations();
+            entry.wall_time_ns = function->getEvaluationTimeInNs();
+            profile.push_back(std::move(entry));
+        }
+        return profile;
     }
 
     /// @name Interface for CasOC::Transcription.
@@ -596,6 +617,29 @@ public:
     /// @}
 
 private:
+    /// All functions that have been constructed by initialize().
+    std::vector<Function*> getFunctions() const {
+        std::vector<Function*> functions;
+        auto append = [&functions](Function* function) {
+            if (function) functions.push_back(function);
+        };
+        for (const auto& info : m_costInfos) {
+            append(info.integrand_function.get());
+            append(info.endpoint_function.get());
+        }
+        for (const auto& info : m_endpointConstraintInfos) {
+            append(info.integrand_function.get());
+            append(info.endpoint_function.get());
+        }
+        for (const auto& info : m_pathInfos) append(info.function.get());
+        append(m_multibodyFunc.get());
+        append(m_multibodyFuncIgnoringConstraints.get());
+        append(m_implicitMultibodyFunc.get());
+        append(m_implicitMultibodyFuncIgnoringConstraints.get());
+        append(m_velocityCorrectionFunc.get());
+        return functions;
+    }
+
     /// Clip endpoint to be as strict as b.
     void clipEndpointBounds(const Bounds& b, Bounds& endpoint) {
         endpoint.lower = std::max(b.lower, endpoint.lower);
@@ -16,6 +16,8 @@
  * -------------------------------------------------------------------------- */
 
 #include "CasOCHermiteSimpson.h"
+#include "CasOCLegendreGaussRadau.h"
+#include "CasOCMultipleShooting.h"
 #include "CasOCProblem.h"
 #include "CasOCTranscription.h"
 #include "CasOCTrapezoidal.h"
@@ -32,6 +34,12 @@ std::unique_ptr<Transcription> Solver::createTranscription() const {
         transcription = OpenSim::make_unique<Trapezoidal>(*this, m_problem);
     } else if (m_transcriptionScheme == "hermite-simpson") {
         transcription = OpenSim::make_unique<HermiteSimpson>(*this, m_problem);
+    } else if (m_transcriptionScheme == "legendre-gauss-radau") {
+        transcription =
+                OpenSim::make_unique<LegendreGaussRadau>(*this, m_problem);
+    } else if (m_transcriptionScheme == "multiple-shooting") {
+        transcription =
+                OpenSim::make_unique<MultipleShooting>(*this, m_problem);
     } else {
         OPENSIM_THROW(Exception, "Unknown transcription scheme '{}'.",
                 m_transcriptionScheme);
@@ -61,6 +69,18 @@ void Solver::setSparsityDetectionRandomCount(int count) {
     m_sparsity_detection_random_count = count;
 }
 
+void Solver::setMultipleShootingNumSteps(int numSteps) {
+    OPENSIM_THROW_IF(numSteps < 1, OpenSim::Exception,
+            "Expected numSteps >= 1 but got {}.", numSteps);
+    m_multipleShootingNumSteps = numSteps;
+}
+
+void Solver::setInterpolatingPolynomialDegree(int degree) {
+    OPENSIM_THROW_IF(degree < 1, OpenSim::Exception,
+            "Expected degree >= 1 but got {}.", degree);
+    m_interpolatingPolynomialDegree = degree;
+}
+
 void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_parallelism = parallelism;
     OPENSIM_THROW_IF(numThreads < 1, OpenSim::Exception,
@@ -93,7 +113,8 @@ Solution Solver::solve(const Iterate& guess) const {
     }
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
-                    pointsForSparsityDetection));
+                    pointsForSparsityDetection),
+            m_profileCallbacks);
     return transcription->solve(guess);
 }
 
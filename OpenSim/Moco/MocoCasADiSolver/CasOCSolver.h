@@ -105,6 +105,23 @@ public:
         m_implicitAuxiliaryDerivativesWeight = weight;
     }
 
+    /// The number of fixed Runge-Kutta steps used to integrate each mesh
+    /// interval.
+    /// @note Only applies to multiple shooting transcription.
+    void setMultipleShootingNumSteps(int numSteps);
+    int getMultipleShootingNumSteps() const {
+        return m_multipleShootingNumSteps;
+    }
+
+    /// The degree of the polynomial that interpolates the states within each
+    /// mesh interval; this is also the number of collocation points per mesh
+    /// interval.
+    /// @note Only applies to Legendre-Gauss-Radau transcription.
+    void setInterpolatingPolynomialDegree(int degree);
+    int getInterpolatingPolynomialDegree() const {
+        return m_interpolatingPolynomialDegree;
+    }
+
     /// Whether or not to constrain control values at mesh interval midpoints
     /// by linearly interpolating control values from mesh interval endpoints.
     /// @note Only applies to Hermite-Simpson collocation.
@@ -141,6 +158,13 @@ public:
         return m_finite_difference_scheme;
     }
 
+    /// Record the number of calls to, and the wall time spent in, each
+    /// CasOC::Function and each NLP oracle function. The results are stored
+    /// in Solution::profile.
+    /// @note Default is false.
+    void setProfileCallbacks(bool tf) { m_profileCallbacks = tf; }
+    bool getProfileCallbacks() const { return m_profileCallbacks; }
+
     void setCallbackInterval(int callbackInterval) {
         m_callbackInterval = callbackInterval;
     }
@@ -203,12 +227,15 @@ private:
     double m_implicitAuxiliaryDerivativesWeight = 1.0;
     bool m_interpolateControlMidpoints = true;
     bool m_enforcePathConstraintMidpoints = false;
+    int m_multipleShootingNumSteps = 4;
+    int m_interpolatingPolynomialDegree = 3;
     Bounds m_implicitMultibodyAccelerationBounds;
     Bounds m_implicitAuxiliaryDerivativeBounds;
     std::string m_finite_difference_scheme = "central";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
     int m_callbackInterval = 0;
+    bool m_profileCallbacks = false;
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
     int m_numThreads = 1;
@@ -750,6 +750,9 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     solution.times = createTimes(
             solution.variables[initial_time], solution.variables[final_time]);
     solution.stats = nlpFunc.stats();
+    if (m_solver.getProfileCallbacks()) {
+        solution.profile = createProfile(solution.stats);
+    }
 
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
@@ -766,6 +769,47 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     return solution;
 }
 
+Profile Transcription::createProfile(const casadi::Dict& stats) const {
+    // CasADi records the number of calls to, and the wall time spent in, each
+    // NLP oracle function (e.g., "nlp_jac_g"). The derivative oracles
+    // (nlp_grad_f, nlp_jac_g, nlp_hess_l) are where CasADi evaluates the
+    // CasOC::Functions to compute finite differences.
+    Profile profile;
+    long long oracleTimeInNs = 0;
+    const std::string prefix = "t_wall_nlp_";
+    for (const auto& stat : stats) {
+        const std::string& key = stat.first;
+        if (key.compare(0, prefix.size(), prefix) != 0) continue;
+        ProfileEntry entry;
+        entry.name = key.substr(std::string("t_wall_").size());
+        const auto numCalls = stats.find("n_call_" + entry.name);
+        if (numCalls != stats.end()) {
+            entry.num_calls = (long long)numCalls->second.as_int();
+        }
+        entry.wall_time_ns =
+                (long long)std::llround(1e9 * stat.second.as_double());
+        oracleTimeInNs += entry.wall_time_ns;
+        profile.push_back(std::move(entry));
+    }
+    // Whatever time was not spent in the oracle functions was spent in the
+    // optimizer itself (e.g., IPOPT's linear solver).
+    if (stats.count("t_wall_total")) {
+        ProfileEntry entry;
+        entry.name = m_solver.getOptimSolver();
+        if (stats.count("iter_count")) {
+            entry.num_calls = (long long)stats.at("iter_count").as_int();
+        }
+        entry.wall_time_ns = (long long)std::llround(
+                                     1e9 * stats.at("t_wall_total").as_double()) -
+                             oracleTimeInNs;
+        profile.push_back(std::move(entry));
+    }
+    const Profile functionProfile = m_problem.createFunctionProfile();
+    profile.insert(profile.end(), functionProfile.begin(),
+            functionProfile.end());
+    return profile;
+}
+
 void Transcription::printConstraintValues(const Iterate& it,
         const Constraints<casadi::DM>& constraints,
         std::ostream& stream) const {
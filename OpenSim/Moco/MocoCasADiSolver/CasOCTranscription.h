@@ -137,6 +137,13 @@ protected:
     void printObjectiveBreakdown(const Iterate& it,
             const casadi::DM& objectiveTerms,
             std::ostream& stream = std::cout) const;
+    /// The optimization variables, in their unscaled form. This is useful for
+    /// transcription schemes whose defects depend on variables other than the
+    /// states and state derivatives (e.g., controls).
+    const VariablesMX& getUnscaledVariables() const { return m_unscaledVars; }
+    /// Combine the NLP oracle statistics from CasADi with the evaluation
+    /// counts of the problem's CasOC::Functions.
+    Profile createProfile(const casadi::Dict& stats) const;
 
     const Solver& m_solver;
     const Problem& m_problem;
@@ -48,12 +48,16 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_parallel();
     constructProperty_output_interval(0);
 
+    constructProperty_profile_callbacks(false);
+
     constructProperty_minimize_implicit_multibody_accelerations(false);
     constructProperty_implicit_multibody_accelerations_weight(1.0);
     constructProperty_minimize_implicit_auxiliary_derivatives(false);
     constructProperty_implicit_auxiliary_derivatives_weight(1.0);
 
     constructProperty_enforce_path_constraint_midpoints(false);
+    constructProperty_interpolating_polynomial_degree(3);
+    constructProperty_multiple_shooting_num_steps(4);
 }
 
 bool MocoCasADiSolver::isAvailable() {
@@ -192,12 +196,18 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     Dict solverOptions;
     checkPropertyValueIsInSet(getProperty_optim_solver(), {"ipopt", "snopt"});
     checkPropertyValueIsInSet(getProperty_transcription_scheme(),
-            {"trapezoidal", "hermite-simpson"});
+            {"trapezoidal", "hermite-simpson", "legendre-gauss-radau",
+                    "multiple-shooting"});
     OPENSIM_THROW_IF(casProblem.getNumKinematicConstraintEquations() != 0 &&
-                             get_transcription_scheme() == "trapezoidal",
+                             get_transcription_scheme() != "hermite-simpson",
+            OpenSim::Exception,
+            "Kinematic constraints not supported with {} transcription.",
+            get_transcription_scheme());
+    OPENSIM_THROW_IF(get_transcription_scheme() == "multiple-shooting" &&
+                             get_multibody_dynamics_mode() != "explicit",
             OpenSim::Exception,
-            "Kinematic constraints not supported with "
-            "trapezoidal transcription.");
+            "Multiple shooting transcription requires 'explicit' "
+            "multibody_dynamics_mode.");
     // Enforcing constraint derivatives is only supported when Hermite-Simpson
     // is set as the transcription scheme.
     if (casProblem.getNumKinematicConstraintEquations() != 0) {
@@ -282,6 +292,7 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
 
     casSolver->setCallbackInterval(get_output_interval());
+    casSolver->setProfileCallbacks(get_profile_callbacks());
 
     Dict pluginOptions;
     pluginOptions["verbose_init"] = true;
@@ -329,6 +340,14 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
             get_interpolate_control_midpoints());
     casSolver->setEnforcePathConstraintMidpoints(
             get_enforce_path_constraint_midpoints());
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_interpolating_polynomial_degree(), 1,
+            std::numeric_limits<int>::max(), {});
+    casSolver->setInterpolatingPolynomialDegree(
+            get_interpolating_polynomial_degree());
+    checkPropertyValueIsInRangeOrSet(getProperty_multiple_shooting_num_steps(),
+            1, std::numeric_limits<int>::max(), {});
+    casSolver->setMultipleShootingNumSteps(get_multiple_shooting_num_steps());
     if (casProblem.getJarSize() > 1) {
         casSolver->setParallelism("thread", casProblem.getJarSize());
     }
@@ -430,10 +449,22 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
             casSolution.objective, casSolution.stats.at("return_status"),
             casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
+    if (get_profile_callbacks()) {
+        std::vector<std::tuple<std::string, long long, double>> profile;
+        for (const auto& entry : casSolution.profile) {
+            profile.emplace_back(entry.name, entry.num_calls,
+                    SimTK::nsToSec(entry.wall_time_ns));
+        }
+        setSolutionProfile(mocoSolution, profile);
+    }
 
     if (get_verbosity()) {
         log_info(std::string(72, '-'));
         log_info("Elapsed real time: {}.", stopwatch.formatNs(elapsed));
+        if (get_profile_callbacks()) {
+            log_info("Profile of callbacks:");
+            mocoSolution.printProfile();
+        }
         log_info(getFormattedDateTime(false, "%c"));
         if (mocoSolution) {
             log_info("MocoCasADiSolver succeeded!");
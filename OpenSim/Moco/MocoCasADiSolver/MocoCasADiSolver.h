@@ -98,6 +98,41 @@ not affect the solution. We encourage you to use the environment variable
 instead, as this allows different users to solve the same problem with the
 parallelization they prefer.
 
+Pseudospectral transcription
+============================
+This solver also supports 'legendre-gauss-radau' orthogonal collocation.
+Within each mesh interval, the states are interpolated by a polynomial of
+degree `interpolating_polynomial_degree` and the dynamics are enforced at the
+Legendre-Gauss-Radau points of the interval. For smooth problems, this
+converges with far fewer mesh intervals than 'hermite-simpson'. The solution
+contains the states and controls at all collocation points, so the time
+points are not uniformly spaced even if the mesh is. Kinematic constraints
+are not supported with this scheme.
+
+Multiple shooting
+=================
+In addition to the 'trapezoidal' and 'hermite-simpson' transcription schemes
+of MocoDirectCollocationSolver, this solver supports 'multiple-shooting'.
+Each mesh interval is a shooting segment that is integrated with
+`multiple_shooting_num_steps` fixed fourth-order Runge-Kutta steps, and only
+the states at the mesh points are optimization variables. The optimization
+problem is therefore smaller than with direct collocation, and the segments
+are integrated in parallel (see Parallelization above). Multiple shooting
+requires the 'explicit' multibody_dynamics_mode and does not support
+kinematic constraints or auxiliary dynamics in implicit form.
+
+Profiling
+=========
+If a problem solves slowly, set the profile_callbacks property to true to
+find out where the time goes. The solver then records, for each function
+that invokes OpenSim (the multibody system, each MocoGoal's integrand and
+endpoint, each MocoPathConstraint) the number of evaluations and the total
+wall time spent in them. Most of these evaluations come from computing
+finite differences; the time spent computing derivatives is reported by the
+nlp_grad_f, nlp_jac_g, and nlp_hess_l entries, and the time spent within the
+optimizer itself (e.g., IPOPT's linear solver) is reported by the entry named
+after the optimizer. See MocoSolution::printProfile().
+
 Parameter variables
 ===================
 By default, MocoCasADiSolver is much slower than MocoTroperSolver at
@@ -154,6 +189,13 @@ public:
             "each iteration is saved, 5 indicates every fifth iteration is "
             "saved, etc.");
 
+    OpenSim_DECLARE_PROPERTY(profile_callbacks, bool,
+            "Record the number of calls to, and the wall time spent in, each "
+            "function that evaluates the model (multibody system, goals, path "
+            "constraints) and each NLP oracle function. The profile is printed "
+            "at the end of the solve and stored in the MocoSolution. "
+            "Default: false.");
+
     OpenSim_DECLARE_PROPERTY(minimize_implicit_multibody_accelerations, bool,
             "Minimize the integral of the squared acceleration continuous "
             "variables when using the implicit multibody mode. "
@@ -171,6 +213,17 @@ public:
             "'minimize_implicit_auxiliary_derivatives' is enabled."
             "Default: 1.0.");
 
+    OpenSim_DECLARE_PROPERTY(interpolating_polynomial_degree, int,
+            "If the transcription scheme is set to 'legendre-gauss-radau', the "
+            "degree of the polynomial that interpolates the states within "
+            "each mesh interval (i.e., the number of collocation points per "
+            "mesh interval). Default: 3.");
+
+    OpenSim_DECLARE_PROPERTY(multiple_shooting_num_steps, int,
+            "If the transcription scheme is set to 'multiple-shooting', the "
+            "number of fourth-order Runge-Kutta steps used to integrate each "
+            "mesh interval. Default: 4.");
+
     OpenSim_DECLARE_PROPERTY(enforce_path_constraint_midpoints, bool,
             "If the transcription scheme is set to 'hermite-simpson', then "
             "enable this property to enforce MocoPathConstraints at mesh "
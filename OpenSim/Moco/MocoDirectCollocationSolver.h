@@ -100,7 +100,9 @@ public:
             "2 for output from CasADi and the underlying solver (default: 2).");
     OpenSim_DECLARE_PROPERTY(transcription_scheme, std::string,
             "'trapezoidal' for trapezoidal transcription, or 'hermite-simpson' "
-            "(default) for separated Hermite-Simpson transcription.");
+            "(default) for separated Hermite-Simpson transcription. "
+            "MocoCasADiSolver also supports 'legendre-gauss-radau' and "
+            "'multiple-shooting'.");
     OpenSim_DECLARE_PROPERTY(interpolate_control_midpoints, bool,
             "If the transcription scheme is set to 'hermite-simpson', then "
             "enable this property to constrain the control values at mesh "
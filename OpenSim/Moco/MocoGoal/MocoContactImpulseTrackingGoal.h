@@ -23,6 +23,9 @@
 
 namespace OpenSim {
 
+    class ContactHalfSpace;
+    class ContactSphere;
+    class MultiSmoothSphereHalfSpaceForce;
     class SmoothSphereHalfSpaceForce;
     /**
     \section MocoContactImpulseTrackingGoalGroup
@@ -50,7 +53,8 @@ namespace OpenSim {
         OpenSim_DECLARE_CONCRETE_OBJECT(MocoContactImpulseTrackingGoalGroup, Object);
     public:
         OpenSim_DECLARE_LIST_PROPERTY(contact_force_paths, std::string,
-            "Paths to SmoothSphereHalfSpaceForce objects in the model whose "
+            "Paths to SmoothSphereHalfSpaceForce and "
+                "MultiSmoothSphereHalfSpaceForce objects in the model whose "
             "combined contact impulse is compared to the contact impulse "
             "from a single ExternalForce.");
         OpenSim_DECLARE_PROPERTY(external_force_name, std::string,
@@ -81,7 +85,10 @@ namespace OpenSim {
     the left and right feet in gait requires separate instances of this goal.
     Tracking ground reaction impulses for multiple axes requires separate 
     instances of this goal.
-    @note The only contact element supported is SmoothSphereHalfSpaceForce.
+    @note The supported contact elements are SmoothSphereHalfSpaceForce and
+    MultiSmoothSphereHalfSpaceForce. Each sphere of a
+    MultiSmoothSphereHalfSpaceForce is paired with the ExternalForce as if it
+    had its own SmoothSphereHalfSpaceForce.
     @note This goal does not include torques or centers of pressure.
     This goal is computed as follows:
     \f[
@@ -242,11 +249,13 @@ namespace OpenSim {
 
         void constructProperties();
 
-        /// For a given contact force, find the starting index of the forces from
-        /// SmoothSphereHalfSpaceForce::getRecordValues().
+        /// For the contact between a sphere and a half space, find the starting
+        /// index of the forces from SmoothSphereHalfSpaceForce::getRecordValues():
+        /// 0 for the forces on the sphere and 6 for the forces on the half space.
         int findRecordOffset(
             const MocoContactImpulseTrackingGoalGroup& group,
-            const SmoothSphereHalfSpaceForce& contactForce,
+            const Force& contactForce, const ContactSphere& sphere,
+            const ContactHalfSpace& halfSpace,
             const std::string& appliedToBody) const;
 
         mutable double m_denominator;
@@ -257,6 +266,11 @@ namespace OpenSim {
         /// experimental data.
         struct GroupInfo {
             std::vector<std::pair<const SmoothSphereHalfSpaceForce*, int>> contacts;
+            /// The sign of the force on each sphere of a
+            /// MultiSmoothSphereHalfSpaceForce: 1 for the force on the sphere and
+            /// -1 for the force on the half space.
+            std::vector<std::pair<const MultiSmoothSphereHalfSpaceForce*,
+                    std::vector<double>>> multiContacts;
             GCVSplineSet refSplines;
             const PhysicalFrame* refExpressedInFrame = nullptr;
         };
@@ -17,6 +17,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoContactTrackingGoal.h"
+#include <OpenSim/Simulation/Model/MultiSmoothSphereHalfSpaceForce.h>
 #include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
 
 using namespace OpenSim;
@@ -158,10 +159,28 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
         for (int ic = 0; ic < group.getProperty_contact_force_paths().size();
                 ++ic) {
             const auto& path = group.get_contact_force_paths(ic);
+            if (model.hasComponent<MultiSmoothSphereHalfSpaceForce>(path)) {
+                const auto& contactForce = model.getComponent<
+                        MultiSmoothSphereHalfSpaceForce>(path);
+                const auto& halfSpace =
+                        contactForce.getConnectee<ContactHalfSpace>("half_space");
+                const int numSpheres = contactForce.getNumContactSpheres();
+                std::vector<double> signs;
+                for (int is = 0; is < numSpheres; ++is) {
+                    int recordOffset = findRecordOffset(group, contactForce,
+                            contactForce.getContactSphere(is), halfSpace,
+                            extForce.get_applied_to_body());
+                    signs.push_back(recordOffset == 0 ? 1.0 : -1.0);
+                }
+                groupInfo.multiContacts.emplace_back(&contactForce, signs);
+                continue;
+            }
             const auto& contactForce =
                     model.getComponent<SmoothSphereHalfSpaceForce>(path);
 
             int recordOffset = findRecordOffset(group, contactForce,
+                    contactForce.getConnectee<ContactSphere>("sphere"),
+                    contactForce.getConnectee<ContactHalfSpace>("half_space"),
                     extForce.get_applied_to_body());
 
             groupInfo.contacts.push_back(
@@ -258,13 +277,13 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
 
 int MocoContactTrackingGoal::findRecordOffset(
         const MocoContactTrackingGoalGroup& group,
-        const SmoothSphereHalfSpaceForce& contactForce,
+        const Force& contactForce, const ContactSphere& sphere,
+        const ContactHalfSpace& halfSpace,
         const std::string& appliedToBody) const {
 
     // Is the ExternalForce applied to the sphere's body?
     const auto& sphereBase =
-            contactForce.getConnectee<ContactSphere>("sphere")
-                    .getConnectee<PhysicalFrame>("frame")
+            sphere.getConnectee<PhysicalFrame>("frame")
                     .findBaseFrame();
     const std::string& sphereBaseName = sphereBase.getName();
     if (sphereBaseName == appliedToBody) {
@@ -276,8 +295,7 @@ int MocoContactTrackingGoal::findRecordOffset(
 
     // Is the ExternalForce applied to the half space's body?
     const auto& halfSpaceBase =
-            contactForce.getConnectee<ContactHalfSpace>("half_space")
-                    .getConnectee<PhysicalFrame>("frame")
+            halfSpace.getConnectee<PhysicalFrame>("frame")
                     .findBaseFrame();
     const std::string& halfSpaceBaseName = halfSpaceBase.getName();
     if (halfSpaceBaseName == appliedToBody) {
@@ -318,6 +336,8 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
 
     integrand = 0;
     SimTK::Vec3 force_ref;
+    SimTK::Vector_<SimTK::Vec3> sphereForces;
+    SimTK::Vector_<SimTK::Vec3> spherePoints;
     for (int ig = 0; ig < (int)m_groups.size(); ++ig) {
 
         // Get contact groups.
@@ -332,6 +352,12 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
                 force_model[im] += recordValues[recordOffset + im];
             }
         }
+        for (const auto& entry : group.multiContacts) {
+            entry.first->calcSphereForces(state, sphereForces, spherePoints);
+            for (int is = 0; is < sphereForces.size(); ++is) {
+                force_model += entry.second[is] * sphereForces[is];
+            }
+        }
 
         // Reference force.
         for (int ir = 0; ir < force_ref.size(); ++ir) {
@@ -23,6 +23,9 @@
 
 namespace OpenSim {
 
+class ContactHalfSpace;
+class ContactSphere;
+class MultiSmoothSphereHalfSpaceForce;
 class SmoothSphereHalfSpaceForce;
 /** 
 \section MocoContactTrackingGoalGroup
@@ -52,7 +55,8 @@ class OSIMMOCO_API MocoContactTrackingGoalGroup : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoContactTrackingGoalGroup, Object);
 public:
     OpenSim_DECLARE_LIST_PROPERTY(contact_force_paths, std::string,
-            "Paths to SmoothSphereHalfSpaceForce objects in the model whose "
+            "Paths to SmoothSphereHalfSpaceForce and "
+            "MultiSmoothSphereHalfSpaceForce objects in the model whose "
             "forces are summed and compared to the data from a single "
             "ExternalForce.");
     OpenSim_DECLARE_PROPERTY(external_force_name, std::string,
@@ -83,7 +87,10 @@ This class handles multiple groups of contact forces and a single
 experimental external loads file. Tracking ground reaction forces for the
 left and right feet in gait requires only one instance of this goal.
 
-@note The only contact element supported is SmoothSphereHalfSpaceForce.
+@note The supported contact elements are SmoothSphereHalfSpaceForce and
+MultiSmoothSphereHalfSpaceForce. Each sphere of a
+MultiSmoothSphereHalfSpaceForce is paired with the ExternalForce as if it
+had its own SmoothSphereHalfSpaceForce.
 
 @note This goal does not include torques or centers of pressure.
 
@@ -302,11 +309,13 @@ private:
 
     void constructProperties();
 
-    /// For a given contact force, find the starting index of the forces from
-    /// SmoothSphereHalfSpaceForce::getRecordValues().
+    /// For the contact between a sphere and a half space, find the starting
+    /// index of the forces from SmoothSphereHalfSpaceForce::getRecordValues():
+    /// 0 for the forces on the sphere and 6 for the forces on the half space.
     int findRecordOffset(
             const MocoContactTrackingGoalGroup& group,
-            const SmoothSphereHalfSpaceForce& contactForce,
+            const Force& contactForce, const ContactSphere& sphere,
+            const ContactHalfSpace& halfSpace,
             const std::string& appliedToBody) const;
 
     enum class ProjectionType {
@@ -324,6 +333,11 @@ private:
     /// experimental data.
     struct GroupInfo {
         std::vector<std::pair<const SmoothSphereHalfSpaceForce*, int>> contacts;
+        /// The sign of the force on each sphere of a
+        /// MultiSmoothSphereHalfSpaceForce: 1 for the force on the sphere and
+        /// -1 for the force on the half space.
+        std::vector<std::pair<const MultiSmoothSphereHalfSpaceForce*,
+                std::vector<double>>> multiContacts;
         GCVSplineSet refSplines;
         const PhysicalFrame* refExpressedInFrame = nullptr;
         SimTK::Vec3 normalizeFactors = SimTK::Vec3(1.0);
@@ -17,6 +17,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoStepTimeAsymmetryGoal.h"
+#include <OpenSim/Simulation/Model/MultiSmoothSphereHalfSpaceForce.h>
 #include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
 
 using namespace OpenSim;
@@ -66,6 +67,16 @@ void MocoStepTimeAsymmetryGoal::initializeOnModelImpl(const Model& model) const
             "group, but none were found.");
     for (int ic = 0; ic < numLeftPaths; ++ic) {
         const auto& path = get_left_contact_group().get_contact_force_paths(ic);
+        if (model.hasComponent<MultiSmoothSphereHalfSpaceForce>(path)) {
+            const auto& contactForce =
+                    model.getComponent<MultiSmoothSphereHalfSpaceForce>(path);
+            m_left_multi_contacts.emplace_back(&contactForce);
+            if (path == leftPositionForcePath) {
+                m_left_frame = &contactForce.getContactSphere(0)
+                        .getConnectee<PhysicalFrame>("frame").findBaseFrame();
+            }
+            continue;
+        }
         const auto& contactForce =
                 model.getComponent<SmoothSphereHalfSpaceForce>(path);
         m_left_contacts.emplace_back(&contactForce);
@@ -92,6 +103,16 @@ void MocoStepTimeAsymmetryGoal::initializeOnModelImpl(const Model& model) const
             "contact group, but none were found.");
     for (int ic = 0; ic < numRightPaths; ++ic) {
         const auto& path = get_right_contact_group().get_contact_force_paths(ic);
+        if (model.hasComponent<MultiSmoothSphereHalfSpaceForce>(path)) {
+            const auto& contactForce =
+                    model.getComponent<MultiSmoothSphereHalfSpaceForce>(path);
+            m_right_multi_contacts.emplace_back(&contactForce);
+            if (path == rightPositionForcePath) {
+                m_right_frame = &contactForce.getContactSphere(0)
+                        .getConnectee<PhysicalFrame>("frame").findBaseFrame();
+            }
+            continue;
+        }
         const auto& contactForce =
                 model.getComponent<SmoothSphereHalfSpaceForce>(path);
         m_right_contacts.emplace_back(&contactForce);
@@ -160,6 +181,22 @@ void MocoStepTimeAsymmetryGoal::calcIntegrandImpl(
         Array<double> recordValues = contact->getRecordValues(state);
         rightForce += m_contact_force_sign * recordValues[m_contact_force_index];
     }
+    SimTK::Vector_<SimTK::Vec3> sphereForces;
+    SimTK::Vector_<SimTK::Vec3> spherePoints;
+    for (const auto& contact : m_left_multi_contacts) {
+        contact->calcSphereForces(state, sphereForces, spherePoints);
+        for (int is = 0; is < sphereForces.size(); ++is) {
+            leftForce += m_contact_force_sign *
+                         sphereForces[is][m_contact_force_index];
+        }
+    }
+    for (const auto& contact : m_right_multi_contacts) {
+        contact->calcSphereForces(state, sphereForces, spherePoints);
+        for (int is = 0; is < sphereForces.size(); ++is) {
+            rightForce += m_contact_force_sign *
+                          sphereForces[is][m_contact_force_index];
+        }
+    }
 
     // Right is negative such that shorter right step times give negative
     // asymmetry values.
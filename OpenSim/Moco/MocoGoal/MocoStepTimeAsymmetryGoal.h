@@ -22,6 +22,7 @@
 
 namespace OpenSim {
 
+class MultiSmoothSphereHalfSpaceForce;
 class SmoothSphereHalfSpaceForce;
 
 /** A contact group includes a list of contact force component paths in the
@@ -36,12 +37,14 @@ class OSIMMOCO_API MocoStepTimeAsymmetryGoalGroup : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoStepTimeAsymmetryGoalGroup, Object);
 public:
     OpenSim_DECLARE_LIST_PROPERTY(contact_force_paths, std::string,
-            "Paths to SmoothSphereHalfSpaceForce objects on one foot of the "
+            "Paths to SmoothSphereHalfSpaceForce and "
+            "MultiSmoothSphereHalfSpaceForce objects on one foot of the "
             "model whose forces are summed to determine when the foot is in "
             "contact with the ground.");
     OpenSim_DECLARE_PROPERTY(foot_position_contact_force_path, std::string,
-            "Path to a SmoothSphereHalfSpaceForce whose ContactSphere is used "
-            "to locate the position of the foot, which is necessary for "
+            "Path to a SmoothSphereHalfSpaceForce whose ContactSphere (or a "
+            "MultiSmoothSphereHalfSpaceForce whose first ContactSphere) is "
+            "used to locate the position of the foot, which is necessary for "
             "computing the step time during the double support phase of "
             "walking. This path should match one of the paths in "
             "'contact_force_paths'.");
@@ -86,7 +89,8 @@ functions which can be controlled via 'setAsymmetrySmoothing()' and
 
 @note This goal is designed for simulations of bipedal gait.
 
-@note The only contact element supported is SmoothSphereHalfSpaceForce.
+@note The supported contact elements are SmoothSphereHalfSpaceForce and
+MultiSmoothSphereHalfSpaceForce.
 
 @note Since this goal approximates step time asymmetry, users should calculate
 the true asymmetry value after running an optimization.
@@ -225,6 +229,12 @@ private:
         m_left_contacts;
     mutable std::vector<SimTK::ReferencePtr<const SmoothSphereHalfSpaceForce>>
         m_right_contacts;
+    mutable std::vector<
+            SimTK::ReferencePtr<const MultiSmoothSphereHalfSpaceForce>>
+        m_left_multi_contacts;
+    mutable std::vector<
+            SimTK::ReferencePtr<const MultiSmoothSphereHalfSpaceForce>>
+        m_right_multi_contacts;
     mutable SimTK::ReferencePtr<const Frame> m_left_frame;
     mutable SimTK::ReferencePtr<const Frame> m_right_frame;
 
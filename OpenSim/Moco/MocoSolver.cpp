@@ -101,6 +101,17 @@ void MocoSolver::setSolutionStats(MocoSolution& sol, bool success,
     sol.setObjectiveBreakdown(std::move(objectiveBreakdown));
 }
 
+void MocoSolver::setSolutionProfile(MocoSolution& sol,
+        const std::vector<std::tuple<std::string, long long, double>>&
+                profile) {
+    std::vector<MocoSolution::ProfileEntry> entries;
+    for (const auto& entry : profile) {
+        entries.push_back({std::get<0>(entry), std::get<1>(entry),
+                std::get<2>(entry)});
+    }
+    sol.setProfile(std::move(entries));
+}
+
 std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
         MocoSolver::createProblemRepJar(int size) const {
     auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>();
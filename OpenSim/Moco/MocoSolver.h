@@ -23,6 +23,8 @@
 
 #include <SimTKcommon/internal/ReferencePtr.h>
 
+#include <tuple>
+
 #include <OpenSim/Common/Object.h>
 
 namespace OpenSim {
@@ -89,6 +91,13 @@ protected:
             std::vector<std::pair<std::string, double>> objectiveBreakdown =
                     {});
 
+    /// Store the number of calls and wall time (seconds) of each profiled part
+    /// of the optimization in the solution. Entries are (name, calls,
+    /// duration).
+    static void setSolutionProfile(MocoSolution&,
+            const std::vector<std::tuple<std::string, long long, double>>&
+                    profile);
+
     const MocoProblemRep& getProblemRep() const {
         return m_problemRep;
     }
@@ -1446,6 +1446,48 @@ void MocoSolution::printObjectiveBreakdown() const {
     }
 }
 
+std::vector<std::string> MocoSolution::getProfileEntryNames() const {
+    std::vector<std::string> names;
+    for (const auto& entry : m_profile) { names.push_back(entry.name); }
+    return names;
+}
+
+const MocoSolution::ProfileEntry& MocoSolution::getProfileEntry(
+        const std::string& name) const {
+    for (const auto& entry : m_profile) {
+        if (entry.name == name) { return entry; }
+    }
+    OPENSIM_THROW(Exception, "Profile entry '{}' not found.", name);
+}
+
+long long MocoSolution::getProfileEntryNumCalls(const std::string& name) const {
+    return getProfileEntry(name).numCalls;
+}
+
+double MocoSolution::getProfileEntryDuration(const std::string& name) const {
+    return getProfileEntry(name).duration;
+}
+
+void MocoSolution::printProfile() const {
+    if (m_profile.empty()) {
+        log_cout("No profile available");
+        return;
+    }
+    std::size_t nameWidth = 0;
+    for (const auto& entry : m_profile) {
+        nameWidth = std::max(nameWidth, entry.name.size());
+    }
+    log_cout("{:<{}} {:>12} {:>12} {:>14}", "name", nameWidth, "calls",
+            "time (s)", "time/call (us)");
+    for (const auto& entry : m_profile) {
+        const double perCall = entry.numCalls
+                                       ? 1e6 * entry.duration / entry.numCalls
+                                       : 0.0;
+        log_cout("{:<{}} {:>12} {:>12.4f} {:>14.2f}", entry.name, nameWidth,
+                entry.numCalls, entry.duration, perCall);
+    }
+}
+
 void MocoSolution::convertToTableImpl(TimeSeriesTable& table) const {
     std::string success = m_success ? "true" : "false";
     table.updTableMetaData().setValueForKey("success", success);
@@ -981,6 +981,26 @@ public:
     void printObjectiveBreakdown() const;
     /// @}
 
+    /// @name Solver profile
+    /// Some solvers can record how many times, and for how long, each part of
+    /// the optimization was evaluated (see, for example, MocoCasADiSolver's
+    /// `profile_callbacks` property). Use these functions to access this
+    /// profile. Durations are wall times in seconds; for functions evaluated
+    /// in parallel, the duration is summed across threads.
+    /// @{
+
+    /// Get the names of the entries in the profile. If the solver did not
+    /// record a profile, then this returns an empty vector.
+    std::vector<std::string> getProfileEntryNames() const;
+    /// Get the number of times the profiled entry was evaluated.
+    long long getProfileEntryNumCalls(const std::string& name) const;
+    /// Get the total wall time (seconds) spent in the profiled entry.
+    double getProfileEntryDuration(const std::string& name) const;
+    /// Print to the console the number of calls and the duration of each
+    /// entry in the profile.
+    void printProfile() const;
+    /// @}
+
     /// @name Access control
     /// @{
 
@@ -1022,6 +1042,15 @@ private:
         m_numIterations = numIterations;
     };
     void setSolverDuration(double duration) { m_solverDuration = duration; }
+    struct ProfileEntry {
+        std::string name;
+        long long numCalls;
+        double duration;
+    };
+    void setProfile(std::vector<ProfileEntry> profile) {
+        m_profile = std::move(profile);
+    }
+    const ProfileEntry& getProfileEntry(const std::string& name) const;
     void convertToTableImpl(TimeSeriesTable&) const override;
     bool m_success = true;
     double m_objective = -1;
@@ -1029,6 +1058,7 @@ private:
     std::string m_status;
     int m_numIterations = -1;
     double m_solverDuration = -1;
+    std::vector<ProfileEntry> m_profile;
     // Allow solvers to set success, status, and construct a solution.
     friend class MocoSolver;
 };
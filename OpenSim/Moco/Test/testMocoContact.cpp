@@ -523,6 +523,86 @@ TEST_CASE("testSmoothSphereHalfSpaceForce", "[casadi]") {
     testSmoothSphereHalfSpaceForce_FrictionForce(equilibriumHeight);
 }
 
+TEST_CASE("Contact goals accept MultiSmoothSphereHalfSpaceForce") {
+
+    // Tracking a MultiSmoothSphereHalfSpaceForce must give the same integrands
+    // as tracking a SmoothSphereHalfSpaceForce with the same sphere and
+    // contact parameters, whether the data is applied to the sphere's body or
+    // to the half space's body.
+    Model model(createBallHalfSpaceModel());
+    const auto& single = model.getComponent<SmoothSphereHalfSpaceForce>(
+            "contactBallHalfSpace");
+    auto* multi = new MultiSmoothSphereHalfSpaceForce("multi",
+            model.getComponent<ContactHalfSpace>("contactgeometryset/floor"));
+    multi->addContactSphere("/contactgeometryset/sphere");
+    multi->set_stiffness(single.get_stiffness());
+    multi->set_dissipation(single.get_dissipation());
+    multi->set_static_friction(single.get_static_friction());
+    multi->set_dynamic_friction(single.get_dynamic_friction());
+    multi->set_viscous_friction(single.get_viscous_friction());
+    multi->set_transition_velocity(single.get_transition_velocity());
+    multi->set_constant_contact_force(single.get_constant_contact_force());
+    multi->set_hertz_smoothing(single.get_hertz_smoothing());
+    multi->set_hunt_crossley_smoothing(single.get_hunt_crossley_smoothing());
+    model.addComponent(multi);
+
+    SimTK::State state = model.initSystem();
+    model.setStateVariableValue(state,
+            "groundBall/groundBall_coord_2/value", 0.095);
+    model.setStateVariableValue(state,
+            "groundBall/groundBall_coord_1/speed", 0.2);
+    model.setStateVariableValue(state,
+            "groundBall/groundBall_coord_2/speed", -0.1);
+    model.realizeVelocity(state);
+
+    const std::string dataFileName =
+            "testContact_MultiSmoothSphereHalfSpaceForce_external_loads.sto";
+    {
+        TimeSeriesTable data;
+        data.setColumnLabels({"ground_force_r_vx", "ground_force_r_vy",
+                "ground_force_r_vz"});
+        for (int i = 0; i <= 10; ++i) {
+            data.appendRow(0.1 * i, {1.0, 20.0, -2.0});
+        }
+        STOFileAdapter::write(data, dataFileName);
+    }
+
+    for (const std::string appliedToBody : {"ball", "ground"}) {
+        ExternalLoads extLoads;
+        extLoads.setDataFileName(dataFileName);
+        auto extForce = make_unique<ExternalForce>();
+        extForce->setName("right");
+        extForce->set_applied_to_body(appliedToBody);
+        extForce->set_force_identifier("ground_force_r_v");
+        extLoads.adoptAndAppend(extForce.release());
+
+        std::vector<double> tracking;
+        std::vector<double> impulseTracking;
+        for (const std::string path : {"contactBallHalfSpace", "multi"}) {
+            MocoProblem problem;
+            problem.setModelAsCopy(model);
+            auto* goal = problem.addGoal<MocoContactTrackingGoal>();
+            goal->setExternalLoads(extLoads);
+            goal->addContactGroup({path}, "right");
+            goal->initializeOnModel(model);
+            tracking.push_back(goal->calcIntegrand({0, state, {}}));
+
+            auto* impulseGoal =
+                    problem.addGoal<MocoContactImpulseTrackingGoal>();
+            impulseGoal->setExternalLoads(extLoads);
+            impulseGoal->addContactGroup({path}, "right");
+            impulseGoal->setImpulseAxis(1);
+            impulseGoal->initializeOnModel(model);
+            impulseTracking.push_back(
+                    impulseGoal->calcIntegrand({0, state, {}}));
+        }
+        CHECK(tracking[0] > 1.0);
+        CHECK(tracking[1] == Approx(tracking[0]).epsilon(1e-10));
+        CHECK(std::abs(impulseTracking[0]) > 1.0);
+        CHECK(impulseTracking[1] == Approx(impulseTracking[0]).epsilon(1e-10));
+    }
+}
+
 TEST_CASE("MocoContactTrackingGoal", "[casadi]") {
 
     // We drop a ball from a prescribed initial height, record the contact
@@ -1760,6 +1760,54 @@ TEMPLATE_TEST_CASE("Sliding mass", "", MocoCasADiSolver, MocoTropterSolver) {
     }
 }
 
+TEST_CASE("Sliding mass with Legendre-Gauss-Radau transcription",
+        "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    const int degree = GENERATE(1, 3, 4);
+    const int numMeshIntervals = 6;
+    solver.set_transcription_scheme("legendre-gauss-radau");
+    solver.set_interpolating_polynomial_degree(degree);
+    solver.set_num_mesh_intervals(numMeshIntervals);
+    MocoSolution solution = study.solve();
+
+    // The grid contains the collocation points of each mesh interval and the
+    // final mesh point.
+    const int numTimes = degree * numMeshIntervals + 1;
+    REQUIRE(solution.getNumTimes() == numTimes);
+    const double finalTime = solution.getFinalTime();
+    CHECK(finalTime == Approx(2.0).epsilon(1e-2));
+    const SimTK::Vector& time = solution.getTime();
+    for (int imesh = 0; imesh <= numMeshIntervals; ++imesh) {
+        CHECK(time[degree * imesh] ==
+                Approx(finalTime * imesh / numMeshIntervals).margin(1e-10));
+    }
+    const auto& states = solution.getStatesTrajectory();
+    CHECK(states(numTimes - 1, 0) == Approx(1.0).margin(1e-6));
+    CHECK(states(numTimes - 1, 1) == Approx(0.0).margin(1e-6));
+}
+
+TEST_CASE("Sliding mass with multiple shooting", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_transcription_scheme("multiple-shooting");
+    solver.set_multiple_shooting_num_steps(2);
+    MocoSolution solution = study.solve();
+    const int numTimes = 20;
+    REQUIRE(solution.getNumTimes() == numTimes);
+    const double expectedFinalTime = 2.0;
+    CHECK(solution.getFinalTime() == Approx(expectedFinalTime).epsilon(1e-2));
+    const auto& states = solution.getStatesTrajectory();
+    CHECK(states(numTimes - 1, 0) == Approx(1.0).margin(1e-6));
+    CHECK(states(numTimes - 1, 1) == Approx(0.0).margin(1e-6));
+
+    SECTION("Implicit dynamics not supported") {
+        solver.set_multibody_dynamics_mode("implicit");
+        CHECK_THROWS_WITH(study.solve(),
+                Catch::Contains("requires 'explicit'"));
+    }
+}
+
 TEMPLATE_TEST_CASE("Solving an empty MocoProblem", "",
         MocoCasADiSolver, MocoTropterSolver) {
     MocoStudy study;
@@ -2055,6 +2103,29 @@ TEST_CASE("Objective breakdown", "[casadi]") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("Profile callbacks", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    SECTION("Profiling disabled by default") {
+        MocoSolution solution = study.solve();
+        CHECK(solution.getProfileEntryNames().empty());
+    }
+    SECTION("Profiling enabled") {
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_profile_callbacks(true);
+        MocoSolution solution = study.solve();
+        const auto names = solution.getProfileEntryNames();
+        CHECK(std::find(names.begin(), names.end(), "ipopt") != names.end());
+        CHECK(std::find(names.begin(), names.end(), "nlp_jac_g") !=
+                names.end());
+        CHECK(solution.getProfileEntryNumCalls("explicit_multibody_system") >
+                0);
+        CHECK(solution.getProfileEntryDuration("explicit_multibody_system") >
+                0);
+        CHECK_THROWS_AS(solution.getProfileEntryNumCalls("nonexistent"),
+                Exception);
+    }
+}
+
 TEST_CASE("generateAccelerationsFromXXX() does not overwrite existing "
           "non-accleration derivatives.") {
     int N = 20;
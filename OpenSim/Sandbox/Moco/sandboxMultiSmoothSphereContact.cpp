@@ -0,0 +1,127 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: sandboxMultiSmoothSphereContact.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Time the evaluation of the accelerations of a block that touches the
+// ground with many contact spheres, modeled either with one
+// SmoothSphereHalfSpaceForce per sphere or with a single
+// MultiSmoothSphereHalfSpaceForce. The accelerations of both models are
+// checked to match.
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/ContactHalfSpace.h>
+#include <OpenSim/Simulation/Model/ContactSphere.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/MultiSmoothSphereHalfSpaceForce.h>
+#include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
+#include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+
+using namespace OpenSim;
+using SimTK::Vec3;
+
+template <typename ContactForce>
+void setContactParameters(ContactForce& force) {
+    force.set_stiffness(1e6);
+    force.set_dissipation(2.0);
+    force.set_static_friction(0.8);
+    force.set_dynamic_friction(0.6);
+    force.set_viscous_friction(0.1);
+    force.set_transition_velocity(0.2);
+}
+
+std::unique_ptr<Model> createModel(int numSpheres, bool useMultiForce) {
+    auto model = OpenSim::make_unique<Model>();
+    auto* block = new Body("block", 2.0, Vec3(0), SimTK::Inertia(0.1));
+    model->addBody(block);
+    model->addJoint(new FreeJoint("free", model->getGround(), *block));
+
+    auto* floor = new ContactHalfSpace(Vec3(0), Vec3(0, 0, -0.5 * SimTK::Pi),
+            model->getGround(), "floor");
+    model->addContactGeometry(floor);
+
+    auto* multi = new MultiSmoothSphereHalfSpaceForce("multi", *floor);
+    setContactParameters(*multi);
+    for (int i = 0; i < numSpheres; ++i) {
+        // Spheres on a circle under the block.
+        const double angle = 2 * SimTK::Pi * i / numSpheres;
+        const std::string name = "sphere" + std::to_string(i);
+        auto* sphere = new ContactSphere(0.02,
+                Vec3(0.1 * std::cos(angle), -0.03, 0.1 * std::sin(angle)),
+                *block, name);
+        model->addContactGeometry(sphere);
+        if (useMultiForce) {
+            multi->addContactSphere(sphere->getAbsolutePathString());
+        } else {
+            auto* single = new SmoothSphereHalfSpaceForce(
+                    "single" + std::to_string(i), *sphere, *floor);
+            setContactParameters(*single);
+            model->addForce(single);
+        }
+    }
+    if (useMultiForce) {
+        model->addForce(multi);
+    } else {
+        delete multi;
+    }
+    model->finalizeConnections();
+    return model;
+}
+
+// The average time to realize the accelerations, over states in which the
+// block slides and rocks on the ground.
+double timeEvaluations(Model& model, int numEvaluations,
+        SimTK::Vector& udot) {
+    SimTK::State& state = model.initSystem();
+    Stopwatch watch;
+    for (int i = 0; i < numEvaluations; ++i) {
+        state.updQ() = 0;
+        state.updQ()[0] = 0.02 * std::sin(0.01 * i);
+        state.updQ()[4] = 0.035;
+        state.updU() = 0;
+        state.updU()[0] = 0.5;
+        state.updU()[3] = 0.3;
+        state.updU()[4] = -0.1;
+        model.realizeAcceleration(state);
+    }
+    udot = state.getUDot();
+    return SimTK::nsToSec(watch.getElapsedTimeInNs()) / numEvaluations;
+}
+
+int main() {
+    const int numEvaluations = 20000;
+    for (int numSpheres : {2, 4, 8, 16, 32}) {
+        auto singles = createModel(numSpheres, false);
+        auto multi = createModel(numSpheres, true);
+        SimTK::Vector udotSingles, udotMulti;
+        const double timeSingles =
+                timeEvaluations(*singles, numEvaluations, udotSingles);
+        const double timeMulti =
+                timeEvaluations(*multi, numEvaluations, udotMulti);
+        const double difference = (udotSingles - udotMulti).normInf();
+        std::cout << numSpheres << " spheres: "
+                  << 1e6 * timeSingles << " us with "
+                  << "SmoothSphereHalfSpaceForce per sphere, "
+                  << 1e6 * timeMulti << " us with "
+                  << "MultiSmoothSphereHalfSpaceForce (speedup "
+                  << timeSingles / timeMulti << "); max udot difference "
+                  << difference << std::endl;
+        OPENSIM_THROW_IF(difference > 1e-8 * (1 + udotSingles.normInf()),
+                Exception, "The accelerations of the models differ.");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#ifndef OPENSIM_BUFFERED_MARKERS_REFERENCE_H_
+#define OPENSIM_BUFFERED_MARKERS_REFERENCE_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  BufferedMarkersReference.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include "BufferedReference.h"
+#include "MarkersReference.h"
+
+namespace OpenSim {
+
+/**
+ * Subclass of MarkersReference that handles live marker data (e.g., from an
+ * optical motion capture system) by providing a buffer that allows clients
+ * to push data into and allows the InverseKinematicsSolver to draw data from
+ * for solving. See BufferedReference_ for the streaming interface.
+ */
+class OSIMSIMULATION_API BufferedMarkersReference
+        : public BufferedReference_<MarkersReference> {
+    OpenSim_DECLARE_CONCRETE_OBJECT(BufferedMarkersReference,
+            BufferedReference_<MarkersReference>);
+
+public:
+    BufferedMarkersReference() = default;
+
+    // Use the MarkersReference constructors from a file or TimeSeriesTable.
+    using BufferedReference_<MarkersReference>::BufferedReference_;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BUFFERED_MARKERS_REFERENCE_H_
@@ -21,56 +21,12 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include "BufferedOrientationsReference.h"
-#include "OrientationsReference.h"
-#include <OpenSim/Common/Units.h>
-#include <OpenSim/Common/TRCFileAdapter.h>
-#include <SimTKcommon/internal/State.h>
-
-using namespace std;
-using namespace SimTK;
 
 namespace OpenSim {
 
 BufferedOrientationsReference::BufferedOrientationsReference()
-        : OrientationsReference() {
+        : BufferedReference_<OrientationsReference>() {
     setAuthors("Ayman Habib");
 }
 
-/** get the values of the OrientationsReference */
-void BufferedOrientationsReference::getValuesAtTime(
-        double time, SimTK::Array_<Rotation> &values) const
-{
-    auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-
-    if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
-    } else {
-        _orientationDataQueue.pop_front(time, nextRow);
-    }
-    int n = nextRow.size();
-    values.resize(n);
-
-    for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
-    }
-}
-
-double BufferedOrientationsReference::getNextValuesAndTime(
-        SimTK::Array_<SimTK::Rotation_<double>>& values) {
-
-    double returnTime;
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(returnTime, nextRow);
-    int n = nextRow.size();
-    values.resize(n);
-
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
-    return returnTime;
-}
-
-void BufferedOrientationsReference::putValues(
-        double time, const SimTK::RowVector_<SimTK::Rotation_<double>>& dataRow) {
-    _orientationDataQueue.push_back(time, dataRow);
-}
 } // end of namespace OpenSim
\ No newline at end of file
@@ -23,8 +23,8 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "BufferedReference.h"
 #include "OrientationsReference.h"
-#include <OpenSim/Common/DataQueue.h>
 
 namespace OpenSim {
 
@@ -32,18 +32,18 @@ namespace OpenSim {
 //=============================================================================
 //=============================================================================
 /**
- * Subclass of OrientationsReference that handles live data by providing a DataQueue
- * that allows clients to push data into and allows the InverseKinematicsSolver to 
- * draw data from for solving.
- * Ideally this would be templatized, allowing for all Reference classes to leverage it.
+ * Subclass of OrientationsReference that handles live data by providing a
+ * buffer that allows clients to push data into and allows the
+ * InverseKinematicsSolver to draw data from for solving.
+ * See BufferedReference_ for the streaming interface.
  *
  * @author Ayman Habib
  */
 
 class OSIMSIMULATION_API BufferedOrientationsReference
-        : public OrientationsReference {
-    OpenSim_DECLARE_CONCRETE_OBJECT(
-            BufferedOrientationsReference, OrientationsReference);
+        : public BufferedReference_<OrientationsReference> {
+    OpenSim_DECLARE_CONCRETE_OBJECT(BufferedOrientationsReference,
+            BufferedReference_<OrientationsReference>);
  //=============================================================================
 // METHODS
 //=============================================================================
@@ -54,45 +54,13 @@ public:
     BufferedOrientationsReference();
     BufferedOrientationsReference(
             const BufferedOrientationsReference&) = default;
-    BufferedOrientationsReference(BufferedOrientationsReference&&) = default;
     BufferedOrientationsReference& operator=(
             const BufferedOrientationsReference&) = default;
 
     // Use OrientationsReference convenience costructor from TimeSeriesTable
-    using OrientationsReference::OrientationsReference;
+    using BufferedReference_<OrientationsReference>::BufferedReference_;
 
     virtual ~BufferedOrientationsReference() {}
-
-    //--------------------------------------------------------------------------
-    // Reference Interface
-    //--------------------------------------------------------------------------
-    /** get the time range for which this Reference values are valid,
-        based on the loaded orientation data.*/
-    SimTK::Vec2 getValidTimeRange() const override{
-        SimTK::Vec2 tableRange = Super::getValidTimeRange();
-        return SimTK::Vec2(tableRange[0], SimTK::Infinity);
-    };
-
-    /** get the values from the base OrientationsReference, or from
-     * the client provided data that was queued earlier using putValues call. */
-    void getValuesAtTime(double time,
-            SimTK::Array_<SimTK::Rotation_<double>>& values) const override;
-
-    /** add passed in values to data procesing Queue */
-    void putValues(double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow);
-
-    double getNextValuesAndTime(
-            SimTK::Array_<SimTK::Rotation_<double>>& values) override;
-
-    virtual bool hasNext() const override { return !_finished; };
-
-    void setFinished(bool finished) { 
-        _finished = finished;
-    };
-private:
-    // Use a specialized data structure for holding the orientation data
-    mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
-    bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
 //=============================================================================
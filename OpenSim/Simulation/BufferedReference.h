@@ -0,0 +1,189 @@
+#ifndef OPENSIM_BUFFERED_REFERENCE_H_
+#define OPENSIM_BUFFERED_REFERENCE_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  BufferedReference.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include "Reference.h"
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * A Reference that adds live data to another type of Reference. Clients push
+ * frames of values (e.g., from a motion capture or IMU stream) with
+ * putValues(), and a solver (e.g., the InverseKinematicsSolver with
+ * InverseKinematicsSolver::setAdvanceTimeFromReference()) draws them with
+ * getNextValuesAndTime(). Names and weights are those of the underlying
+ * Reference, and values at times within the range of its data (e.g., a
+ * table of initial frames used to assemble the model) are taken from it.
+ *
+ * The template argument is the Reference being extended, which must derive
+ * from StreamableReference_, e.g.,
+ * `BufferedReference_<MarkersReference>` (see BufferedMarkersReference) or
+ * `BufferedReference_<OrientationsReference>` (see
+ * BufferedOrientationsReference). Being a subclass of that Reference, the
+ * buffered Reference can be used anywhere the Reference is accepted.
+ *
+ * Frames are passed from one producer thread to one consumer thread through
+ * a lock-free RingBuffer. putValues() waits while the buffer is full and
+ * getNextValuesAndTime() waits while it is empty; tryPutValues() does not
+ * wait. Once setFinished() was called and all frames have been drawn,
+ * drawing another frame throws instead of waiting. A copy of a buffered
+ * Reference has its own, empty, buffer.
+ */
+template <class R>
+class BufferedReference_ : public R {
+    OpenSim_DECLARE_CONCRETE_OBJECT_T(BufferedReference_, R, R);
+
+public:
+    typedef typename R::ValueType ValueType;
+
+    //--------------------------------------------------------------------------
+    // CONSTRUCTION
+    //--------------------------------------------------------------------------
+    BufferedReference_() = default;
+    BufferedReference_(const BufferedReference_& other)
+            : R(other), _frames(new RingBuffer<Frame>(other.getCapacity())),
+              _finished(other._finished.load()) {}
+    BufferedReference_& operator=(const BufferedReference_& other) {
+        if (this != &other) {
+            R::operator=(other);
+            _frames.reset(new RingBuffer<Frame>(other.getCapacity()));
+            _finished = other._finished.load();
+        }
+        return *this;
+    }
+
+    // Use the constructors of the underlying Reference (e.g., from a table).
+    using R::R;
+
+    //--------------------------------------------------------------------------
+    // Reference Interface
+    //--------------------------------------------------------------------------
+    /** The range of the underlying Reference's data, extended to infinity
+        to include the frames that are yet to be pushed. */
+    SimTK::Vec2 getValidTimeRange() const override {
+        return SimTK::Vec2(R::getValidTimeRange()[0], SimTK::Infinity);
+    }
+
+    /** Get the values from the underlying Reference if the time is within
+        the range of its data, otherwise take the next pushed frame.
+        @throws Exception if a frame must be taken but none remain (see
+        hasNext()). */
+    void getValuesAtTime(double time,
+            SimTK::Array_<ValueType>& values) const override {
+        const SimTK::Vec2 range = R::getValidTimeRange();
+        if (time >= range[0] && time <= range[1]) {
+            R::getValuesAtTime(time, values);
+        } else {
+            popFrame(values);
+        }
+    }
+
+    double getNextValuesAndTime(SimTK::Array_<ValueType>& values) override {
+        return popFrame(values);
+    }
+
+    /** Whether frames are queued or may still be pushed, i.e., unless
+        setFinished() was called and all frames have been drawn. */
+    bool hasNext() const override {
+        return !_finished || !_frames->empty();
+    }
+
+    /** Mark the end of the stream once the last frame has been pushed. */
+    void setFinished(bool finished) {
+        _finished = finished;
+        _pushed.notify();
+    }
+
+    //--------------------------------------------------------------------------
+    // Streaming
+    //--------------------------------------------------------------------------
+    /** Add a frame of values, in the order of getNames(), waiting while the
+        buffer is full. Only one thread may push frames. */
+    void putValues(double time, const SimTK::RowVector_<ValueType>& dataRow) {
+        Frame frame{time, dataRow};
+        while (!_frames->tryPush(frame)) std::this_thread::yield();
+        _pushed.notify();
+    }
+    /** Add a frame of values unless the buffer is full, in which case this
+        returns false. */
+    bool tryPutValues(
+            double time, const SimTK::RowVector_<ValueType>& dataRow) {
+        Frame frame{time, dataRow};
+        if (!_frames->tryPush(frame)) return false;
+        _pushed.notify();
+        return true;
+    }
+
+    /** The number of frames the buffer can hold (default: 1024). Changing
+        the capacity discards queued frames, so it must not be changed while
+        frames are being pushed or drawn. */
+    void setCapacity(int capacity) {
+        _frames.reset(new RingBuffer<Frame>(std::max(capacity, 1)));
+    }
+    int getCapacity() const { return (int)_frames->capacity(); }
+
+private:
+    struct Frame {
+        double time = SimTK::NaN;
+        SimTK::RowVector_<ValueType> values;
+    };
+
+    // Wait for the next frame; frames are drawn by a single consumer.
+    double popFrame(SimTK::Array_<ValueType>& values) const {
+        Frame frame;
+        while (!_frames->tryPop(frame)) {
+            // No frame is pushed after setFinished(), so the buffer stays
+            // empty.
+            OPENSIM_THROW_IF_FRMOBJ(_finished && _frames->empty(), Exception,
+                    "Expected another frame, but the stream is finished and "
+                    "all of its frames have been drawn.");
+            _pushed.wait([this] {
+                return !_frames->empty() || _finished.load();
+            });
+        }
+        const int n = frame.values.size();
+        values.resize(n);
+        for (int i = 0; i < n; ++i) { values[i] = frame.values[i]; }
+        return frame.time;
+    }
+
+    std::unique_ptr<RingBuffer<Frame>> _frames{new RingBuffer<Frame>(1024)};
+    std::atomic<bool> _finished{false};
+    // Notified after each pushed frame.
+    mutable IdleWaiter _pushed;
+//=============================================================================
+};  // END of class templatized BufferedReference_<R>
+//=============================================================================
+} // namespace
+
+#endif // OPENSIM_BUFFERED_REFERENCE_H_
@@ -0,0 +1,147 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  EnsembleSimulator.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleSimulator.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace OpenSim;
+
+std::uint64_t EnsembleSimulator::calcMemberSeed(
+        std::uint64_t seed, int index) {
+    // SplitMix64 (Steele, Lea, and Flood, 2014), evaluated at position
+    // index + 1 of the sequence starting at seed.
+    std::uint64_t z =
+            seed + (std::uint64_t(index) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+std::vector<SimTK::State> EnsembleSimulator::simulate(const Model& model,
+        const SimTK::State& initialState, double finalTime, int numMembers) {
+    const double initialTime = initialState.getTime();
+    OPENSIM_THROW_IF(finalTime <= initialTime, Exception,
+            "Expected the final time ({}) to be after the initial time ({}).",
+            finalTime, initialTime);
+    OPENSIM_THROW_IF(numMembers < 0, Exception,
+            "Expected a non-negative number of members, but got {}.",
+            numMembers);
+
+    m_tables.clear();
+    if (!m_tableReporterPath.empty()) m_tables.resize(numMembers);
+    std::vector<SimTK::State> finalStates(numMembers);
+    if (numMembers == 0) return finalStates;
+
+    const int numThreads = getNumThreadsToUse(m_numThreads, numMembers);
+
+    // Copy and initialize the models serially; this is not the expensive
+    // part of an ensemble, and it avoids concurrent access to the
+    // provided model.
+    struct Worker {
+        std::unique_ptr<Model> model;
+        SimTK::State defaultState;
+    };
+    std::vector<Worker> workers(numThreads);
+    for (auto& worker : workers) {
+        worker.model.reset(new Model(model));
+        worker.model->setUseVisualizer(false);
+        worker.defaultState = worker.model->initSystem();
+        OPENSIM_THROW_IF(worker.defaultState.getNY() != initialState.getNY(),
+                Exception,
+                "Expected the initial state to have {} continuous state "
+                "variables, but it has {}.",
+                worker.defaultState.getNY(), initialState.getNY());
+        if (!m_tableReporterPath.empty()) {
+            // Ensure the path is valid before launching the threads.
+            worker.model->getComponent<TableReporter>(m_tableReporterPath);
+        }
+    }
+
+    // Each thread takes the next member that has not been simulated.
+    std::atomic<int> nextMember(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    auto simulateMembers = [&](Worker& worker) {
+        Model& workerModel = *worker.model;
+        try {
+            int index;
+            while ((index = nextMember++) < numMembers) {
+                SimTK::State state = worker.defaultState;
+                state.setTime(initialTime);
+                state.updY() = initialState.getY();
+                if (m_memberFunction) {
+                    std::mt19937_64 rng(calcMemberSeed(m_seed, index));
+                    m_memberFunction(index, rng, workerModel, state);
+                }
+
+                TableReporter* reporter = nullptr;
+                if (!m_tableReporterPath.empty()) {
+                    reporter = &workerModel.updComponent<TableReporter>(
+                            m_tableReporterPath);
+                    reporter->clearTable();
+                }
+
+                Manager manager(workerModel);
+                manager.setWriteToStorage(false);
+                manager.setPerformAnalyses(false);
+                manager.setIntegratorMethod(m_integratorMethod);
+                if (m_integratorAccuracy > 0) {
+                    manager.setIntegratorAccuracy(m_integratorAccuracy);
+                }
+                manager.initialize(state);
+                finalStates[index] = manager.integrate(finalTime);
+
+                if (reporter) m_tables[index] = reporter->getTable();
+                if (m_resultFunction) {
+                    m_resultFunction(index, workerModel, finalStates[index]);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception) exception = std::current_exception();
+            // Prevent other threads from starting new members.
+            nextMember = numMembers;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(simulateMembers, std::ref(workers[ithread]));
+    }
+    simulateMembers(workers[0]);
+    for (auto& thread : threads) thread.join();
+    if (exception) std::rethrow_exception(exception);
+
+    return finalStates;
+}
@@ -0,0 +1,174 @@
+#ifndef OPENSIM_ENSEMBLESIMULATOR_H_
+#define OPENSIM_ENSEMBLESIMULATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  EnsembleSimulator.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Run many forward simulations ("members") of the same model in parallel,
+each starting from a perturbed copy of a common initial state. This is
+useful for Monte-Carlo studies in which the initial conditions, controls or
+parameters of a model are sampled many times.
+
+Each thread gets its own copy of the model, which is initialized once and
+reused for all members simulated on that thread. Threads take the next
+unsimulated member as soon as they are done with their current member, so
+members with longer simulations do not stall the other threads.
+
+Before simulating a member, the simulator calls the member function (see
+setMemberFunction()) with the index of the member, a random number generator,
+the thread's copy of the model, and the initial state of the member. The
+random number generator is seeded with calcMemberSeed(getSeed(), index), so
+the samples drawn for a given member do not depend on the number of threads
+or the order in which members are simulated.
+
+@code
+EnsembleSimulator ensemble;
+ensemble.setSeed(42);
+ensemble.setMemberFunction([](int index, std::mt19937_64& rng,
+        Model& model, SimTK::State& state) {
+    std::normal_distribution<double> noise(0.0, 0.01);
+    const auto& coord = model.getCoordinateSet().get("r_shoulder_elev");
+    coord.setValue(state, coord.getValue(state) + noise(rng));
+});
+SimTK::State& initialState = model.initSystem();
+std::vector<SimTK::State> finalStates =
+        ensemble.simulate(model, initialState, 1.0, 10000);
+@endcode
+
+The initial state of each member contains the time and the continuous state
+variables (Y) of the provided initial state; discrete state variables take
+their default values and can be set in the member function.
+
+The member function may also edit the properties of the model. In that case,
+it must call `state = model.initSystem()` and then set the initial
+conditions. Since the copy of the model is reused for later members on the
+same thread, such a member function must set the edited properties for every
+member.
+
+To obtain results other than the final states, either name a TableReporter in
+the model with setTableReporterPath(), or provide a result function with
+setResultFunction(). The member and result functions are invoked
+concurrently from multiple threads, so they must only modify data associated
+with the given member index.
+
+@note A Manager cannot be reinitialized, so a new Manager is created for each
+member. The Manager does not record states or perform analyses; use a
+reporter to record quantities over time.
+@ingroup simulationutil */
+class OSIMSIMULATION_API EnsembleSimulator {
+public:
+    using MemberFunction = std::function<void(int index, std::mt19937_64& rng,
+            Model& model, SimTK::State& state)>;
+    using ResultFunction = std::function<void(int index, const Model& model,
+            const SimTK::State& finalState)>;
+
+    EnsembleSimulator() = default;
+
+    /// The number of threads used to simulate the members. A value less than
+    /// 1 (the default) means to use the number of hardware threads.
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+
+    /// The seed from which the seeds of the members are derived (default: 0).
+    void setSeed(std::uint64_t seed) { m_seed = seed; }
+    std::uint64_t getSeed() const { return m_seed; }
+
+    /// The integrator used for each member (default: RungeKuttaMerson).
+    void setIntegratorMethod(Manager::IntegratorMethod method)
+    {   m_integratorMethod = method; }
+    Manager::IntegratorMethod getIntegratorMethod() const
+    {   return m_integratorMethod; }
+
+    /// The accuracy of the integrator. A value less than or equal to 0 (the
+    /// default) means to use the default accuracy of the integrator.
+    void setIntegratorAccuracy(double accuracy)
+    {   m_integratorAccuracy = accuracy; }
+    double getIntegratorAccuracy() const { return m_integratorAccuracy; }
+
+    /// Modify the initial state (and, optionally, the model) of a member.
+    void setMemberFunction(MemberFunction function)
+    {   m_memberFunction = std::move(function); }
+
+    /// Invoked on the thread that simulated a member, after the member's
+    /// simulation finishes.
+    void setResultFunction(ResultFunction function)
+    {   m_resultFunction = std::move(function); }
+
+    /// The absolute path to a TableReporter in the model whose table is
+    /// collected for each member (see getTables()). The table is cleared
+    /// before each member is simulated. By default, no tables are collected.
+    void setTableReporterPath(std::string path)
+    {   m_tableReporterPath = std::move(path); }
+    const std::string& getTableReporterPath() const
+    {   return m_tableReporterPath; }
+
+    /// Simulate numMembers members of the provided model from initialTime to
+    /// finalTime and return the final state of each member, in order of
+    /// member index. The model need not be initialized; the provided initial
+    /// state must have the same number of continuous state variables as the
+    /// model. The returned states can be used with the provided model once
+    /// initSystem() is called on it.
+    /// @throws Exception if finalTime is not after the initial time.
+    /// If a member function or simulation throws an exception, the remaining
+    /// members are skipped and the exception is rethrown.
+    std::vector<SimTK::State> simulate(const Model& model,
+            const SimTK::State& initialState, double finalTime,
+            int numMembers);
+
+    /// The tables of the reporter at getTableReporterPath(), in order of
+    /// member index, from the most recent call to simulate().
+    const std::vector<TimeSeriesTable>& getTables() const { return m_tables; }
+
+    /// Deterministically derive the seed of a member from the seed of the
+    /// ensemble (using the SplitMix64 generator). Seeds of neighboring
+    /// members are statistically independent.
+    static std::uint64_t calcMemberSeed(std::uint64_t seed, int index);
+
+private:
+    int m_numThreads = -1;
+    std::uint64_t m_seed = 0;
+    Manager::IntegratorMethod m_integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double m_integratorAccuracy = -1;
+    MemberFunction m_memberFunction;
+    ResultFunction m_resultFunction;
+    std::string m_tableReporterPath;
+    std::vector<TimeSeriesTable> m_tables;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLESIMULATOR_H_
@@ -478,13 +478,51 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     int x = 0;
 
     if (_advanceTimeFromReference) {
-        double nextTime = NaN;
-        if (_orientationsReference &&
-                _orientationsReference->getNumRefs() > 0) {
-            SimTK::Array_<SimTK::Rotation> orientationValues;
-            nextTime = _orientationsReference->getNextValuesAndTime(
+        // Draw the next frame from the references that stream their values;
+        // the others provide their values at the time of that frame.
+        const bool hasMarkers =
+                _markersReference && _markersReference->getNumRefs() > 0;
+        const bool hasOrientations = _orientationsReference &&
+                                     _orientationsReference->getNumRefs() > 0;
+        const bool streamMarkers = hasMarkers && _markersReference->hasNext();
+        const bool streamOrientations =
+                hasOrientations && _orientationsReference->hasNext();
+        OPENSIM_THROW_IF(!streamMarkers && !streamOrientations, Exception,
+                "Expected the markers or the orientations reference to stream "
+                "its values (see setAdvanceTimeFromReference()), but neither "
+                "has a next frame.");
+
+        SimTK::Array_<SimTK::Vec3> markerValues;
+        SimTK::Array_<SimTK::Rotation> orientationValues;
+        double markersTime = NaN;
+        double orientationsTime = NaN;
+        if (streamMarkers) {
+            markersTime = _markersReference->getNextValuesAndTime(markerValues);
+        }
+        if (streamOrientations) {
+            orientationsTime = _orientationsReference->getNextValuesAndTime(
                     orientationValues);
-            s.setTime(nextTime);
+        }
+        OPENSIM_THROW_IF(streamMarkers && streamOrientations &&
+                                 markersTime != orientationsTime,
+                Exception,
+                "The markers reference provided a frame at time {}, but the "
+                "orientations reference provided a frame at time {}.",
+                markersTime, orientationsTime);
+        const double nextTime = streamMarkers ? markersTime : orientationsTime;
+        s.setTime(nextTime);
+
+        if (hasMarkers) {
+            if (!streamMarkers) {
+                _markersReference->getValuesAtTime(nextTime, markerValues);
+            }
+            _markerAssemblyCondition->moveAllObservations(markerValues);
+        }
+        if (hasOrientations) {
+            if (!streamOrientations) {
+                _orientationsReference->getValuesAtTime(
+                        nextTime, orientationValues);
+            }
             _orientationAssemblyCondition->moveAllObservations(
                     orientationValues);
         }
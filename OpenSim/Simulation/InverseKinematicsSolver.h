@@ -25,6 +25,7 @@
 
 #include "AssemblySolver.h"
 #include "MarkersReference.h"
+#include "BufferedMarkersReference.h"
 #include "BufferedOrientationsReference.h"
 
 namespace SimTK {
@@ -226,7 +227,12 @@ public:
     corresponding orientation sensor name for an index in the list of
     orientations returned by the solver. */
     std::string getOrientationSensorNameForIndex(int osensorIndex) const;
-    /** indicate whether time is provided by Reference objects or driver program */
+    /** indicate whether time is provided by Reference objects or driver program.
+    If true, each call to track() draws the next frame from the references
+    whose hasNext() is true (e.g., a BufferedMarkersReference), and takes the
+    values of the other references at the time of that frame. track() throws
+    if no reference has a next frame, or if both references provide a frame
+    but at different times. */
     void setAdvanceTimeFromReference(bool newValue) {
         _advanceTimeFromReference = newValue;
     };
@@ -64,7 +64,8 @@ Manager::Manager(Model& model, bool dummyVar) :
        _model(&model),
        _performAnalyses(true),
        _writeToStorage(true),
-       _controllerSet(&model.updControllerSet())
+       _controllerSet(&model.updControllerSet()),
+       _recordStatesAsynchronously(false)
 {
     setNull();
 
@@ -97,6 +98,7 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _recordStatesAsynchronously=false;
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -114,6 +116,8 @@ constructStorage()
     // STATES
     Array<string> stateNames = _model->getStateVariableNames();
     int ny = stateNames.getSize();
+    flushStateStorage();
+    _stateStoreConsumer.reset();
     _stateStore.reset(new Storage(512,"states"));
     columnLabels.setSize(0);
     columnLabels.append("time");
@@ -611,6 +615,8 @@ void Manager::setIntegratorInternalStepLimit(int nSteps)
 void Manager::
 setStateStorage(Storage& aStorage)
 {
+    flushStateStorage();
+    _stateStoreConsumer.reset();
     _stateStore.reset(&aStorage);
 }
 //_____________________________________________________________________________
@@ -622,9 +628,15 @@ getStateStorage() const
 {
     if(!_stateStore)
         throw Exception("Manager::getStateStorage(): Storage is not set");
+    flushStateStorage();
     return *_stateStore;
 }
 
+void Manager::flushStateStorage() const
+{
+    if (_stateStoreConsumer) _stateStoreConsumer->flush();
+}
+
 TimeSeriesTable Manager::getStatesTable() const {
     return getStateStorage().exportToTable();
 }
@@ -709,6 +721,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     if (time >= stepToTime) {
         // No integration can be performed.
+        flushStateStorage();
         return getState();
     }
 
@@ -739,6 +752,7 @@ const SimTK::State& Manager::integrate(double finalTime)
                         SimTK::Integrator::ReachedFinalTime) {
             log_error("Integration failed due to the following reason: {}",
                 _integ->getTerminationReasonString(_integ->getTerminationReason()));
+            flushStateStorage();
             return getState();
         }
 
@@ -845,9 +859,26 @@ void Manager::record(const SimTK::State& s, const int& step)
     }
     if (_writeToStorage) {
         SimTK::Vector stateValues = _model->getStateVariableValues(s);
-        StateVector vec;
-        vec.setStates(s.getTime(), stateValues);
-        getStateStorage().append(vec);
+        if (_recordStatesAsynchronously) {
+            if (!_stateStoreConsumer) {
+                Storage* stateStore = &getStateStorage();
+                _stateStoreConsumer.reset(new AsyncConsumer<TimeAndStates>(
+                        [stateStore](TimeAndStates& timeAndStates) {
+                            StateVector vec;
+                            vec.setStates(timeAndStates.first,
+                                    timeAndStates.second);
+                            stateStore->append(vec);
+                        }));
+            }
+            _stateStoreConsumer->push(
+                    TimeAndStates(s.getTime(), std::move(stateValues)));
+            // The storage must be complete when the integration ends.
+            if (step < 0) flushStateStorage();
+        } else {
+            StateVector vec;
+            vec.setStates(s.getTime(), stateValues);
+            getStateStorage().append(vec);
+        }
         if (_model->isControlled())
             _controllerSet->storeControls(s,
                 (step < 0) ? getStateStorage().getSize() : step);
@@ -30,6 +30,7 @@
 
 // INCLUDES
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include "OpenSim/Common/TimeSeriesTable.h"
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <SimTKcommon/internal/ReferencePtr.h>
@@ -118,6 +119,15 @@ private:
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
+    /** flag indicating if the states are appended to the storage on a
+    background thread */
+    bool _recordStatesAsynchronously;
+
+    /** Appends states to the storage when recording asynchronously. This is
+    declared after the storage so that it is destroyed first. */
+    using TimeAndStates = std::pair<double, SimTK::Vector>;
+    std::unique_ptr<AsyncConsumer<TimeAndStates>> _stateStoreConsumer;
+
 
 //=============================================================================
 // METHODS
@@ -162,6 +172,15 @@ public:
     { _performAnalyses =  performAnalyses; }
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
+    /** If true, the values of the state variables are obtained on the
+    integration thread, but appended to the state storage on a background
+    thread. This reduces the time spent recording when there are many state
+    variables or many steps. The storage is complete when integrate() returns.
+    This is false by default. */
+    void setRecordStatesAsynchronously(bool recordStatesAsynchronously)
+    { _recordStatesAsynchronously = recordStatesAsynchronously; }
+    bool getRecordStatesAsynchronously() const
+    { return _recordStatesAsynchronously; }
 
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
@@ -363,6 +382,9 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Wait until states recorded asynchronously are in the state storage.
+    void flushStateStorage() const;
+
 //=============================================================================
 };  // END of class Manager
 
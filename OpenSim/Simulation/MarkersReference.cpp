@@ -30,7 +30,7 @@ using namespace SimTK;
 
 namespace OpenSim {
 
-MarkersReference::MarkersReference() : Reference_<SimTK::Vec3>() {
+MarkersReference::MarkersReference() : StreamableReference_<SimTK::Vec3>() {
     constructProperties();
     setAuthors("Ajay Seth");
 }
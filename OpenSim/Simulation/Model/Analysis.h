@@ -209,6 +209,16 @@ public:
     int getStorageInterval() const;
 #endif
     virtual ArrayPtrs<Storage>& getStorageList();
+    /**
+     * Whether separate blocks of a time series may be recorded concurrently
+     * by copies of this analysis (each with its own copy of the model), with
+     * the results obtained by appending, in time order, the rows of the
+     * copies' storages to the storages in getStorageList(). This requires
+     * that the results at each time depend only on the state at that time,
+     * and that all results are held in getStorageList(). Tools like
+     * AnalyzeTool record the other analyses serially. The default is false.
+     */
+    virtual bool getCanRecordInParallel() const { return false; }
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
@@ -0,0 +1,109 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  AnalysisCache.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "AnalysisCache.h"
+#include "GeometryPath.h"
+#include "Model.h"
+#include <OpenSim/Simulation/MomentArmSolver.h>
+
+using namespace OpenSim;
+
+bool AnalysisCache::Configuration::isCurrent(const SimTK::State& s) const {
+    if (!valid) return false;
+    if (topologyVersion != s.getSystemTopologyStageVersion()) return false;
+    const SimTK::Vector& sq = s.getQ();
+    if (sq.size() != q.size()) return false;
+    for (int i = 0; i < q.size(); ++i) {
+        if (sq[i] != q[i]) return false;
+    }
+    return true;
+}
+
+void AnalysisCache::Configuration::set(const SimTK::State& s) {
+    valid = true;
+    topologyVersion = s.getSystemTopologyStageVersion();
+    q = s.getQ();
+}
+
+AnalysisCache::AnalysisCache(const Model& model) : _model(model) {}
+
+AnalysisCache::~AnalysisCache() = default;
+
+void AnalysisCache::requestMomentArms(
+        const std::vector<const GeometryPath*>& paths,
+        const std::vector<const Coordinate*>& coordinates) {
+    bool added = false;
+    for (const GeometryPath* path : paths) {
+        if (_pathIndices.emplace(path, (int)_paths.size()).second) {
+            _paths.push_back(path);
+            added = true;
+        }
+    }
+    for (const Coordinate* coord : coordinates) {
+        if (_coordinateIndices.emplace(coord, (int)_coordinates.size())
+                        .second) {
+            _coordinates.push_back(coord);
+            added = true;
+        }
+    }
+    if (added) _momentArmsConfiguration.valid = false;
+}
+
+double AnalysisCache::getMomentArm(const SimTK::State& s,
+        const GeometryPath& path, const Coordinate& coordinate) {
+    auto pathIt = _pathIndices.find(&path);
+    auto coordIt = _coordinateIndices.find(&coordinate);
+    if (pathIt == _pathIndices.end() || coordIt == _coordinateIndices.end()) {
+        requestMomentArms({&path}, {&coordinate});
+        pathIt = _pathIndices.find(&path);
+        coordIt = _coordinateIndices.find(&coordinate);
+    }
+
+    if (!_momentArmsConfiguration.isCurrent(s)) {
+        if (!_momentArmSolver) {
+            _momentArmSolver.reset(new MomentArmSolver(_model));
+        }
+        _momentArms = _momentArmSolver->solve(s, _coordinates, _paths);
+        _momentArmsConfiguration.set(s);
+    }
+    return _momentArms(pathIt->second, coordIt->second);
+}
+
+const SimTK::Matrix& AnalysisCache::getMassMatrix(const SimTK::State& s) {
+    if (!_massMatrixConfiguration.isCurrent(s)) {
+        _model.getMatterSubsystem().calcM(s, _massMatrix);
+        _massMatrixConfiguration.set(s);
+    }
+    return _massMatrix;
+}
+
+void AnalysisCache::clear() {
+    _paths.clear();
+    _coordinates.clear();
+    _pathIndices.clear();
+    _coordinateIndices.clear();
+    _momentArms.clear();
+    _momentArmsConfiguration.valid = false;
+    _massMatrix.clear();
+    _massMatrixConfiguration.valid = false;
+}
@@ -0,0 +1,130 @@
+#ifndef OPENSIM_ANALYSISCACHE_H_
+#define OPENSIM_ANALYSISCACHE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  AnalysisCache.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include "SimTKcommon/internal/State.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenSim {
+
+class Coordinate;
+class GeometryPath;
+class Model;
+class MomentArmSolver;
+
+/** Quantities that several analyses of a model compute from the same state
+during a time step (frame), computed once per frame and shared between the
+analyses. Analyses obtain the cache of their model with
+Model::updAnalysisCache(). This is infrastructure: a quantity is only shared
+between analyses that read it from the cache of the same Model.
+
+Moment arms are computed together: analyses register the paths and
+coordinates they need (typically in Analysis::begin()) with
+requestMomentArms(), and the first call to getMomentArm() in a frame computes
+the moment arms of all registered paths about all registered coordinates with
+a single MomentArmSolver. This computes the constraint coupling of each
+coordinate and the generalized forces of each path once, instead of once per
+(path, coordinate) pair.
+
+A frame is identified by the generalized coordinates of the state (and the
+topology of the system); the quantities cached here depend only on the
+configuration of the model. The Model empties its cache when its system is
+created.
+
+Currently, MuscleAnalysis reads its moment arms and InverseDynamics reads its
+mass matrix from the cache. Nothing else is shared yet; in particular:
+- StaticOptimization solves on its own working copy of the model (with
+  disabled actuators removed), so it cannot use the cache of the analyzed
+  model. Its analytic constraint Jacobian applies each actuator's force along
+  its path with GeometryPath::addInEquivalentForces() rather than computing
+  moment arms, so it does not reuse those of MuscleAnalysis.
+- JointReaction and InducedAccelerations do not share accelerations.
+  InducedAccelerations computes the accelerations due to each contributor on
+  its own copy of the model, and JointReaction uses the accelerations of the
+  state, which Simbody already caches in the state.
+
+Muscle length information and the forces of the model (including contact
+forces) are already cached in the state by the Muscle and Simbody, so they
+are not duplicated here.
+
+@note The cache is not thread-safe; each copy of a model has its own cache. */
+class OSIMSIMULATION_API AnalysisCache {
+public:
+    explicit AnalysisCache(const Model& model);
+    ~AnalysisCache();
+
+    AnalysisCache(const AnalysisCache&) = delete;
+    AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+    /** Register that the moment arms of the paths about the coordinates will
+    be needed in each frame. Registering pairs that are already registered
+    has no effect. */
+    void requestMomentArms(const std::vector<const GeometryPath*>& paths,
+            const std::vector<const Coordinate*>& coordinates);
+
+    /** The moment arm of the path about the coordinate in the configuration
+    of the state, as computed by GeometryPath::computeMomentArm(). If the path
+    or the coordinate was not registered with requestMomentArms(), it is
+    registered now (and the moment arms of the frame are recomputed). */
+    double getMomentArm(const SimTK::State& s, const GeometryPath& path,
+            const Coordinate& coordinate);
+
+    /** The mass matrix of the model in the configuration of the state, which
+    must be realized to at least Position. */
+    const SimTK::Matrix& getMassMatrix(const SimTK::State& s);
+
+    /** Forget the registered moment arms and all cached values. */
+    void clear();
+
+private:
+    // The configuration from which a cached quantity was computed.
+    struct Configuration {
+        bool valid = false;
+        SimTK::StageVersion topologyVersion = 0;
+        SimTK::Vector q;
+        bool isCurrent(const SimTK::State& s) const;
+        void set(const SimTK::State& s);
+    };
+
+    const Model& _model;
+
+    std::vector<const GeometryPath*> _paths;
+    std::vector<const Coordinate*> _coordinates;
+    std::unordered_map<const GeometryPath*, int> _pathIndices;
+    std::unordered_map<const Coordinate*, int> _coordinateIndices;
+    std::unique_ptr<MomentArmSolver> _momentArmSolver;
+    SimTK::Matrix _momentArms;
+    Configuration _momentArmsConfiguration;
+
+    SimTK::Matrix _massMatrix;
+    Configuration _massMatrixConfiguration;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ANALYSISCACHE_H_
@@ -21,9 +21,9 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
-#include <fstream>
 #include <OpenSim/Common/IO.h>
 #include "ContactMesh.h"
+#include "MeshCache.h"
 #include "Model.h"
 
 namespace OpenSim {
@@ -44,15 +44,13 @@ ContactMesh::ContactMesh(const std::string& filename,
     constructProperties();
     setFilename(filename);
     if (filename != ""){
-        std::ifstream file;
-        file.open(filename.c_str());
-        if (file.fail())
-            throw Exception("Error loading mesh file: "+filename+". The file should exist in same folder with model.\n Model loading is aborted.");
-        file.close();
-        SimTK::PolygonalMesh mesh;
-        mesh.loadFile(filename);
-        _geometry.reset(new SimTK::ContactGeometry::TriangleMesh(mesh));
-        _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
+        // Share the parsed file with other components that use it; the
+        // PolygonalMesh and TriangleMesh are our own copies. This throws if
+        // the file does not exist.
+        _meshData = MeshCache::getMeshData(filename);
+        _geometry.reset(_meshData->createTriangleMesh());
+        _decorativeGeometry.reset(
+                new SimTK::DecorativeMesh(_meshData->createMesh()));
     }
 }
 
@@ -77,6 +75,7 @@ void ContactMesh::constructProperties()
 }
 
 void ContactMesh::extendFinalizeFromProperties() {
+    _meshData.reset();
     _geometry.reset();
     _decorativeGeometry.reset();
 }
@@ -89,6 +88,7 @@ const std::string& ContactMesh::getFilename() const
 void ContactMesh::setFilename(const std::string& filename)
 {
     set_filename(filename);
+    _meshData.reset();
     _geometry.reset();
     _decorativeGeometry.reset();
 }
@@ -96,8 +96,6 @@ void ContactMesh::setFilename(const std::string& filename)
 SimTK::ContactGeometry::TriangleMesh* ContactMesh::
     loadMesh(const std::string& filename) const
 {
-    SimTK::PolygonalMesh mesh;
-    std::ifstream file;
     assert (_model);
 
     auto cwd = IO::CwdChanger::noop();
@@ -106,16 +104,14 @@ SimTK::ContactGeometry::TriangleMesh* ContactMesh::
         cwd = IO::CwdChanger::changeToParentOf(_model->getInputFileName());
     }
 
-    file.open(filename.c_str());
-    if (file.fail()){
-        throw Exception("Error loading mesh file: "+filename+". "
-                "The file should exist in same folder with model.\n "
-                "Loading is aborted.");
-    }
-    file.close();
-    mesh.loadFile(filename);
-    _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
-    return new SimTK::ContactGeometry::TriangleMesh(mesh);
+    // Share the parsed file and its bounding box tree with other components
+    // (e.g., in copies of the model) that use it; this throws if the file
+    // does not exist. The PolygonalMesh, which the DecorativeMesh refers to,
+    // is our own, since copies of its handle are not thread-safe.
+    _meshData = MeshCache::getMeshData(filename);
+    _decorativeGeometry.reset(
+            new SimTK::DecorativeMesh(_meshData->createMesh()));
+    return _meshData->createTriangleMesh();
 }
 
 SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry() const
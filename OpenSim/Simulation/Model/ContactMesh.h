@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "ContactGeometry.h"
+#include "MeshCache.h"
 
 namespace OpenSim {
 
@@ -111,6 +112,10 @@ private:
 //=============================================================================
 // DATA
 //=============================================================================
+    // The mesh loaded from the file, shared (through the MeshCache) with other
+    // components that use the same file, such as copies of this ContactMesh.
+    mutable SimTK::ResetOnCopy<std::shared_ptr<const MeshCache::MeshData>>
+        _meshData;
     mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::ContactGeometry::TriangleMesh>>
         _geometry;
     mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMesh>>
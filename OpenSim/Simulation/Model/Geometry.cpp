@@ -24,7 +24,6 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <fstream>
 #include "Frame.h"
 #include "Geometry.h"
 #include "Model.h"
@@ -219,88 +218,87 @@ void FrameGeometry::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::Decor
 void Mesh::extendFinalizeFromProperties() {
 
     if (!isObjectUpToDateWithProperties()) {
-        const Component* rootModel = nullptr;
-        if (!hasOwner()) {
-            log_error("Mesh {} not connected to model...ignoring",
-                    get_mesh_file());
-            return;   // Orphan Mesh not part of a model yet
-        }
-        const Component* owner = &getOwner();
-        while (owner != nullptr) {
-            if (dynamic_cast<const Model*>(owner) != nullptr) {
-                rootModel = owner;
-                break;
-            }
-            if (owner->hasOwner())
-                owner = &(owner->getOwner()); // traverse up Component tree
-            else
-                break; // can't traverse up.
-        }
+        // The file is searched for when decorations are first generated, so
+        // that models that are never visualized (e.g., copies of a model made
+        // for each thread) do not search the geometry paths for every Mesh.
+        cachedMesh.reset();
+        meshFileSearched = false;
+    }
+}
 
-        if (rootModel == nullptr) {
-            log_error("Mesh {} not connected to model...ignoring",
-                    get_mesh_file());
-            return;   // Orphan Mesh not descendant of a model
-        }
+void Mesh::findMeshFile() const {
+    meshFileSearched = true;
 
-        // Current interface to Visualizer calls generateDecorations on every
-        // frame. On first time through, load file and create DecorativeMeshFile
-        // and cache it so we don't load files from disk during live rendering.
-        const Model* mdl = dynamic_cast<const Model*>(rootModel);
-        const std::string& file = get_mesh_file();
-        if (file.empty() || file.compare(PropertyStr::getDefaultStr()) == 0 ||
-            !mdl->getDisplayHints().isVisualizationEnabled())
-            return;  // Return immediately if no file has been specified
-                     // or display is disabled altogether.
-
-        bool isAbsolutePath; string directory, fileName, extension;
-        SimTK::Pathname::deconstructPathname(file,
-            isAbsolutePath, directory, fileName, extension);
-        const string lowerExtension = SimTK::String::toLower(extension);
-        if (lowerExtension != ".vtp" && lowerExtension != ".obj" && lowerExtension != ".stl") {
-            log_error("ModelVisualizer ignoring '{}'; only .vtp, .stl, and "
-                      ".obj files currently supported.",
-                    file);
-            return;
+    const Component* rootModel = nullptr;
+    if (!hasOwner()) {
+        log_error("Mesh {} not connected to model...ignoring",
+                get_mesh_file());
+        return;   // Orphan Mesh not part of a model yet
+    }
+    const Component* owner = &getOwner();
+    while (owner != nullptr) {
+        if (dynamic_cast<const Model*>(owner) != nullptr) {
+            rootModel = owner;
+            break;
         }
+        if (owner->hasOwner())
+            owner = &(owner->getOwner()); // traverse up Component tree
+        else
+            break; // can't traverse up.
+    }
 
-        // File is a .vtp, .stl, or .obj; attempt to find it.
-        Array_<string> attempts;
-        const Model& model = dynamic_cast<const Model&>(*rootModel);
-        bool foundIt = ModelVisualizer::findGeometryFile(model, file, isAbsolutePath, attempts);
-
-        if (!foundIt) {
-            if (!warningGiven) {
-                log_warn("Couldn't find file '{}'.", file);
-                warningGiven = true;
-            }
-            
-            log_debug( "The following locations were tried:");
-            for (unsigned i = 0; i < attempts.size(); ++i)
-                log_debug(attempts[i]);
-            
-        }
+    if (rootModel == nullptr) {
+        log_error("Mesh {} not connected to model...ignoring",
+                get_mesh_file());
+        return;   // Orphan Mesh not descendant of a model
+    }
 
-        try {
-            std::ifstream objFile;
-            objFile.open(attempts.back().c_str());
-            // objFile closes when destructed
-            // if the file can be opened but had bad contents e.g. binary vtp 
-            // it will be handled downstream 
-        }
-        catch (const std::exception& e) {
-            log_warn("Visualizer couldn't open {} because: {}",
-                attempts.back(), e.what());
-            return;
+    // Current interface to Visualizer calls generateDecorations on every
+    // frame. On first time through, find the file and create a
+    // DecorativeMeshFile and cache it so we don't search for files during
+    // live rendering.
+    const Model* mdl = dynamic_cast<const Model*>(rootModel);
+    const std::string& file = get_mesh_file();
+    if (file.empty() || file.compare(PropertyStr::getDefaultStr()) == 0 ||
+        !mdl->getDisplayHints().isVisualizationEnabled())
+        return;  // Return immediately if no file has been specified
+                 // or display is disabled altogether.
+
+    bool isAbsolutePath; string directory, fileName, extension;
+    SimTK::Pathname::deconstructPathname(file,
+        isAbsolutePath, directory, fileName, extension);
+    const string lowerExtension = SimTK::String::toLower(extension);
+    if (lowerExtension != ".vtp" && lowerExtension != ".obj" && lowerExtension != ".stl") {
+        log_error("ModelVisualizer ignoring '{}'; only .vtp, .stl, and "
+                  ".obj files currently supported.",
+                file);
+        return;
+    }
+
+    // File is a .vtp, .stl, or .obj; attempt to find it.
+    Array_<string> attempts;
+    bool foundIt = ModelVisualizer::findGeometryFile(*mdl, file, isAbsolutePath, attempts);
+
+    if (!foundIt) {
+        if (!warningGiven) {
+            log_warn("Couldn't find file '{}'.", file);
+            warningGiven = true;
         }
 
-        cachedMesh.reset(new DecorativeMeshFile(attempts.back().c_str()));
+        log_debug( "The following locations were tried:");
+        for (unsigned i = 0; i < attempts.size(); ++i)
+            log_debug(attempts[i]);
+        return;
     }
-}
 
+    // The file is read when the mesh is first drawn; a file with bad contents
+    // (e.g., binary vtp) is handled there.
+    cachedMesh.reset(new DecorativeMeshFile(attempts.back().c_str()));
+}
 
 void Mesh::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const
 {
+    if (!meshFileSearched) findMeshFile();
     if (cachedMesh.get() != nullptr) {
         try {
             // Force the loading of the mesh to see if it has bad contents
@@ -560,6 +560,7 @@ public:
     Mesh() :
         Geometry(),
         cachedMesh(nullptr),
+        meshFileSearched(false),
         warningGiven(false)
     {
         constructProperty_mesh_file("");
@@ -568,6 +569,7 @@ public:
     Mesh(const std::string& geomFile) :
         Geometry(),
         cachedMesh(nullptr),
+        meshFileSearched(false),
         warningGiven(false)
     {
         constructProperty_mesh_file("");
@@ -589,10 +591,16 @@ protected:
     void implementCreateDecorativeGeometry(
         SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const override;
 private:
+    // Find the mesh file and create cachedMesh; called when decorations are
+    // first generated.
+    void findMeshFile() const;
+
     // We cache the DecorativeMeshFile if we successfully
     // load the mesh from file so we don't try loading from disk every frame.
     // This is mutable since it is not part of the public interface.
     mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMeshFile>> cachedMesh;
+    // Whether findMeshFile() has been called since the properties changed.
+    mutable SimTK::ReinitOnCopy<bool> meshFileSearched;
     mutable bool warningGiven;
 };
 
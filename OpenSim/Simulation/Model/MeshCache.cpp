@@ -0,0 +1,164 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  MeshCache.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MeshCache.h"
+
+#include <OpenSim/Common/Exception.h>
+#include "simbody/internal/common.h"
+#include "SimTKcommon/internal/PolygonalMesh.h"
+
+#include <map>
+#include <mutex>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+using namespace OpenSim;
+
+namespace {
+
+struct CachedMesh {
+    long long modificationTime = -1;
+    long long size = -1;
+    std::weak_ptr<const MeshCache::MeshData> mesh;
+};
+
+std::mutex& getMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Keyed by the absolute path of the file.
+std::map<std::string, CachedMesh>& getMeshes() {
+    static std::map<std::string, CachedMesh> meshes;
+    return meshes;
+}
+
+// The modification time (in nanoseconds where the platform provides them)
+// and the size of the file; false if the file does not exist.
+bool getFileInfo(const std::string& path, long long& modificationTime,
+        long long& size) {
+#if defined(_MSC_VER)
+    struct _stat64 info;
+    if (_stat64(path.c_str(), &info) != 0) return false;
+    modificationTime = (long long)info.st_mtime;
+#else
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    #if defined(__APPLE__)
+        const struct timespec& mtime = info.st_mtimespec;
+    #else
+        const struct timespec& mtime = info.st_mtim;
+    #endif
+    modificationTime = (long long)mtime.tv_sec * 1000000000LL + mtime.tv_nsec;
+#endif
+    size = (long long)info.st_size;
+    return true;
+}
+
+} // anonymous namespace
+
+SimTK::PolygonalMesh MeshCache::MeshData::createMesh() const {
+    SimTK::PolygonalMesh mesh;
+    for (const auto& vertex : vertices) mesh.addVertex(vertex);
+    SimTK::Array_<int> faceVertices;
+    for (const auto& face : faces) {
+        faceVertices.assign(face.begin(), face.end());
+        mesh.addFace(faceVertices);
+    }
+    return mesh;
+}
+
+SimTK::ContactGeometry::TriangleMesh*
+MeshCache::MeshData::createTriangleMesh() const {
+    return new SimTK::ContactGeometry::TriangleMesh(*triangleMesh);
+}
+
+std::shared_ptr<const MeshCache::MeshData> MeshCache::getMeshData(
+        const std::string& fileName) {
+    const std::string path = SimTK::Pathname::getAbsolutePathname(fileName);
+    long long modificationTime, size;
+    OPENSIM_THROW_IF(!getFileInfo(path, modificationTime, size), Exception,
+            "Could not find mesh file '{}'.", path);
+
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+        auto it = getMeshes().find(path);
+        if (it != getMeshes().end() &&
+                it->second.modificationTime == modificationTime &&
+                it->second.size == size) {
+            if (auto mesh = it->second.mesh.lock()) return mesh;
+        }
+    }
+
+    // Load the mesh without holding the lock, so that different files can be
+    // loaded concurrently. The PolygonalMesh is local to this call; only its
+    // vertices and faces, and the TriangleMesh built from it, are shared.
+    SimTK::PolygonalMesh polygonalMesh;
+    polygonalMesh.loadFile(path);
+    auto mesh = std::make_shared<MeshData>();
+    mesh->vertices.reserve(polygonalMesh.getNumVertices());
+    for (int i = 0; i < polygonalMesh.getNumVertices(); ++i) {
+        mesh->vertices.push_back(polygonalMesh.getVertexPosition(i));
+    }
+    mesh->faces.resize(polygonalMesh.getNumFaces());
+    for (int i = 0; i < polygonalMesh.getNumFaces(); ++i) {
+        auto& face = mesh->faces[i];
+        face.resize(polygonalMesh.getNumVerticesForFace(i));
+        for (int j = 0; j < (int)face.size(); ++j) {
+            face[j] = polygonalMesh.getFaceVertex(i, j);
+        }
+    }
+    mesh->triangleMesh = std::make_shared<
+            const SimTK::ContactGeometry::TriangleMesh>(polygonalMesh);
+
+    std::lock_guard<std::mutex> lock(getMutex());
+    CachedMesh& cached = getMeshes()[path];
+    if (cached.modificationTime == modificationTime && cached.size == size) {
+        // Another thread may have loaded the same file in the meantime; share
+        // its mesh.
+        if (auto existing = cached.mesh.lock()) return existing;
+    }
+    cached.modificationTime = modificationTime;
+    cached.size = size;
+    cached.mesh = mesh;
+    return mesh;
+}
+
+int MeshCache::getNumMeshes() {
+    std::lock_guard<std::mutex> lock(getMutex());
+    int numMeshes = 0;
+    for (auto it = getMeshes().begin(); it != getMeshes().end();) {
+        if (it->second.mesh.expired()) {
+            it = getMeshes().erase(it);
+        } else {
+            ++numMeshes;
+            ++it;
+        }
+    }
+    return numMeshes;
+}
+
+void MeshCache::clear() {
+    std::lock_guard<std::mutex> lock(getMutex());
+    getMeshes().clear();
+}
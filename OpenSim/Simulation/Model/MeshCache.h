@@ -0,0 +1,105 @@
+#ifndef OPENSIM_MESHCACHE_H_
+#define OPENSIM_MESHCACHE_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  MeshCache.h                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+#include "SimTKcommon/SmallMatrix.h"
+#include "simbody/internal/ContactGeometry.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SimTK {
+class PolygonalMesh;
+}
+
+namespace OpenSim {
+
+/** A process-wide cache of the meshes that ContactMesh loads from files, so
+that the components of different models (e.g., the copies of a model made for
+each thread) that use the same file share one parsed mesh instead of each
+reading and parsing the file.
+
+The cache stores the vertices and faces of each mesh as plain arrays (see
+MeshData), not as a SimTK::PolygonalMesh: copies of a PolygonalMesh handle
+share its data but do not update their reference count atomically, so a
+handle must not be shared by components that may be used by different
+threads. Each component instead creates its own PolygonalMesh from the shared
+arrays with MeshData::createMesh(), which is much faster than parsing the
+file. Likewise, the cache builds the SimTK::ContactGeometry::TriangleMesh
+(including its tree of oriented bounding boxes) of each file once, and each
+component receives its own copy from MeshData::createTriangleMesh(); a copy of
+a ContactGeometry is a deep copy of its data, so copying it shares no handle
+and is much faster than building the tree again.
+
+A mesh is identified by the absolute path of its file and the file's
+modification time (with nanosecond resolution, except on Windows) and size,
+so a file that is modified on disk is loaded again. The
+cache holds only weak references: a mesh is freed when the last component
+that uses it is destroyed (or its file changes).
+
+All methods are thread-safe. */
+class OSIMSIMULATION_API MeshCache {
+public:
+    /** The vertices and faces of a mesh loaded from a file. This is not
+    modified after it is loaded, so it may be read by several threads. */
+    struct OSIMSIMULATION_API MeshData {
+        std::vector<SimTK::Vec3> vertices;
+        /** The indices of the vertices of each face. */
+        std::vector<std::vector<int>> faces;
+        /** Create a new SimTK::PolygonalMesh, owned by the caller, with these
+        vertices and faces. */
+        SimTK::PolygonalMesh createMesh() const;
+        /** Create a new SimTK::ContactGeometry::TriangleMesh, owned by the
+        caller, for this mesh. This copies the mesh built when the file was
+        loaded instead of building its bounding box tree again. */
+        SimTK::ContactGeometry::TriangleMesh* createTriangleMesh() const;
+        /** The TriangleMesh that createTriangleMesh() copies. It is never
+        modified or handed out. */
+        std::shared_ptr<const SimTK::ContactGeometry::TriangleMesh>
+                triangleMesh;
+    };
+
+    /** The mesh in the file (.vtp, .stl, or .obj). A relative path is
+    relative to the current working directory. This throws an exception if
+    the file cannot be read. */
+    static std::shared_ptr<const MeshData> getMeshData(
+            const std::string& fileName);
+
+    /** The number of meshes that are currently loaded and in use. */
+    static int getNumMeshes();
+
+    /** Forget all meshes; meshes in use remain valid, but are not shared
+    with later calls to getMeshData(). */
+    static void clear();
+
+private:
+    MeshCache() = delete;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MESHCACHE_H_
@@ -0,0 +1,488 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  MeshElasticFoundationForce.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MeshElasticFoundationForce.h"
+#include "Model.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace OpenSim;
+
+namespace {
+// The maximum number of springs in a leaf of the bounding-volume hierarchy.
+const int MaxSpringsPerLeaf = 8;
+// The number of springs evaluated by a thread at a time; contacts with fewer
+// springs are evaluated by the calling thread only.
+const int SpringsPerBlock = 1024;
+}
+
+//==============================================================================
+//                          MESH DATA AND SPRING
+//==============================================================================
+// The springs of a mesh, sorted so that the springs in each node of the
+// bounding-volume hierarchy are contiguous, and the springs of the mesh that
+// were last selected as candidates for contact with the other mesh.
+struct MeshElasticFoundationForce::MeshData {
+    // A node of the bounding-volume hierarchy; the node's springs are
+    // [begin, end) and are within `radius` of `center` (in the mesh frame),
+    // and the faces of these springs are within `surfaceRadius` of `center`.
+    struct Node {
+        SimTK::Vec3 center;
+        double radius;
+        double surfaceRadius;
+        int begin, end;
+        // Index of the first child node, or -1 for a leaf; the second child
+        // is firstChild + 1.
+        int firstChild;
+    };
+
+    SimTK::ContactGeometry::TriangleMesh geometry;
+    SimTK::MobilizedBodyIndex bodyIndex;
+    // The frame of the mesh in the frame of its body.
+    SimTK::Transform X_BM;
+    std::vector<SimTK::Vec3> springPositions;
+    std::vector<double> springAreas;
+    std::vector<Node> nodes;
+    // The largest distance from the origin of the mesh frame to a spring.
+    double maxSpringDistance = 0;
+
+    // Candidate springs, selected with the mesh at the pose X_OM in the
+    // frame of the other mesh; guarded by candidatesMutex.
+    std::mutex candidatesMutex;
+    bool candidatesValid = false;
+    SimTK::Transform X_OM;
+    std::vector<int> candidates;
+
+    explicit MeshData(const SimTK::ContactGeometry::TriangleMesh& mesh)
+            : geometry(mesh) {
+        const int numFaces = mesh.getNumFaces();
+        std::vector<SimTK::Vec3> positions(numFaces);
+        for (int face = 0; face < numFaces; ++face) {
+            positions[face] = (mesh.getVertexPosition(mesh.getFaceVertex(face, 0))
+                    + mesh.getVertexPosition(mesh.getFaceVertex(face, 1))
+                    + mesh.getVertexPosition(mesh.getFaceVertex(face, 2))) / 3;
+        }
+        std::vector<int> order(numFaces);
+        for (int face = 0; face < numFaces; ++face) order[face] = face;
+        if (numFaces > 0) {
+            nodes.reserve(2 * numFaces / MaxSpringsPerLeaf + 1);
+            nodes.push_back(Node());
+            buildNode(0, 0, numFaces, positions, order);
+        }
+
+        springPositions.resize(numFaces);
+        springAreas.resize(numFaces);
+        for (int i = 0; i < numFaces; ++i) {
+            springPositions[i] = positions[order[i]];
+            springAreas[i] = mesh.getFaceArea(order[i]);
+            maxSpringDistance =
+                    std::max(maxSpringDistance, springPositions[i].norm());
+        }
+
+        for (Node& node : nodes) {
+            node.surfaceRadius = 0;
+            for (int i = node.begin; i < node.end; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    const SimTK::Vec3& vertex = mesh.getVertexPosition(
+                            mesh.getFaceVertex(order[i], k));
+                    node.surfaceRadius = std::max(node.surfaceRadius,
+                            (vertex - node.center).norm());
+                }
+            }
+        }
+    }
+
+    // Fill in nodes[index] for the springs order[begin, end), splitting the
+    // springs at the median of their positions along the axis on which the
+    // positions are most spread out. The node is the sphere that encloses the
+    // axis-aligned bounds of the positions.
+    void buildNode(int index, int begin, int end,
+            const std::vector<SimTK::Vec3>& positions, std::vector<int>& order) {
+        SimTK::Vec3 low(SimTK::Infinity), high(-SimTK::Infinity);
+        for (int i = begin; i < end; ++i) {
+            const SimTK::Vec3& position = positions[order[i]];
+            for (int k = 0; k < 3; ++k) {
+                low[k] = std::min(low[k], position[k]);
+                high[k] = std::max(high[k], position[k]);
+            }
+        }
+        Node& node = nodes[index];
+        node.center = (low + high) / 2;
+        node.radius = (high - low).norm() / 2;
+        node.begin = begin;
+        node.end = end;
+        node.firstChild = -1;
+        if (end - begin <= MaxSpringsPerLeaf) return;
+
+        const SimTK::Vec3 size = high - low;
+        const int axis = size[0] >= size[1] ?
+                (size[0] >= size[2] ? 0 : 2) : (size[1] >= size[2] ? 1 : 2);
+        const int middle = (begin + end) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle,
+                order.begin() + end, [&](int a, int b) {
+                    return positions[a][axis] < positions[b][axis];
+                });
+        const int firstChild = (int)nodes.size();
+        nodes[index].firstChild = firstChild;
+        nodes.push_back(Node());
+        nodes.push_back(Node());
+        buildNode(firstChild, begin, middle, positions, order);
+        buildNode(firstChild + 1, middle, end, positions, order);
+    }
+
+    // Whether the sphere with the given center (in the mesh frame) and
+    // radius may intersect the faces in node `index`.
+    bool mayIntersectSurface(int index, const SimTK::Vec3& center,
+            double radius) const {
+        const Node& node = nodes[index];
+        const double reach = node.surfaceRadius + radius;
+        if ((center - node.center).normSqr() > reach * reach) return false;
+        if (node.firstChild < 0) return true;
+        return mayIntersectSurface(node.firstChild, center, radius) ||
+               mayIntersectSurface(node.firstChild + 1, center, radius);
+    }
+
+    // Select the springs that may be inside the other mesh, or within the
+    // margin of its surface, given the pose of this mesh in the frame of the
+    // other mesh. The nodes of this mesh are tested against the nodes of
+    // the other mesh: a node whose springs (enlarged by the margin) cannot
+    // reach the surface of the other mesh is entirely inside or entirely
+    // outside the other mesh, which is decided by testing its center.
+    void selectCandidates(const SimTK::Transform& pose,
+            const MeshData& other, double margin) {
+        X_OM = pose;
+        candidatesValid = true;
+        candidates.clear();
+        if (nodes.empty() || other.nodes.empty()) return;
+        std::vector<int> stack(1, 0);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            const SimTK::Vec3 center = X_OM * node.center;
+            bool select;
+            if (!other.mayIntersectSurface(0, center, node.radius + margin)) {
+                bool inside;
+                SimTK::UnitVec3 normal;
+                other.geometry.findNearestPoint(center, inside, normal);
+                select = inside;
+            } else if (node.firstChild < 0) {
+                select = true;
+            } else {
+                stack.push_back(node.firstChild + 1);
+                stack.push_back(node.firstChild);
+                continue;
+            }
+            if (select) {
+                for (int i = node.begin; i < node.end; ++i) {
+                    candidates.push_back(i);
+                }
+            }
+        }
+    }
+
+    // Whether a spring that was not selected (with the spheres of the nodes
+    // enlarged by the margin) could now be inside the other mesh, that is,
+    // whether the springs moved by more than the margin relative to the
+    // other mesh since they were selected.
+    bool needsNewCandidates(const SimTK::Transform& pose,
+            double margin) const {
+        if (!candidatesValid) return true;
+        const double angle = (pose.R() * ~X_OM.R())
+                .convertRotationToAngleAxis()[0];
+        const double motion = (pose.p() - X_OM.p()).norm()
+                + std::abs(angle) * maxSpringDistance;
+        return motion > margin;
+    }
+};
+
+// The force of a spring on the body of its mesh (the opposite force acts on
+// the body of the other mesh), applied at the given stations of the bodies.
+struct MeshElasticFoundationForce::Spring {
+    bool active;
+    SimTK::Vec3 force;
+    SimTK::Vec3 station;
+    SimTK::Vec3 otherStation;
+};
+
+//==============================================================================
+//                      MESH ELASTIC FOUNDATION FORCE
+//==============================================================================
+MeshElasticFoundationForce::MeshElasticFoundationForce() {
+    constructProperties();
+}
+
+MeshElasticFoundationForce::MeshElasticFoundationForce(const std::string& name,
+        const ContactMesh& mesh1, const ContactMesh& mesh2) {
+    constructProperties();
+    setName(name);
+    connectSocket_mesh1(mesh1);
+    connectSocket_mesh2(mesh2);
+}
+
+void MeshElasticFoundationForce::constructProperties() {
+    constructProperty_stiffness(0.0);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_candidate_margin(0.005);
+    constructProperty_num_threads(1);
+}
+
+void MeshElasticFoundationForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+
+    OPENSIM_THROW_IF_FRMOBJ(
+        (SimTK::isNaN(get_stiffness()) || get_stiffness() < 0),
+        InvalidPropertyValue, getProperty_stiffness().getName(),
+        "Stiffness cannot be less than zero");
+    OPENSIM_THROW_IF_FRMOBJ(
+        (SimTK::isNaN(get_transition_velocity()) ||
+                get_transition_velocity() <= 0),
+        InvalidPropertyValue, getProperty_transition_velocity().getName(),
+        "Transition velocity must be greater than zero");
+    OPENSIM_THROW_IF_FRMOBJ(
+        (SimTK::isNaN(get_candidate_margin()) || get_candidate_margin() < 0),
+        InvalidPropertyValue, getProperty_candidate_margin().getName(),
+        "Candidate margin cannot be less than zero");
+}
+
+void MeshElasticFoundationForce::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    auto createMeshData = [](const ContactMesh& mesh) {
+        const SimTK::ContactGeometry geometry =
+                mesh.createSimTKContactGeometry();
+        auto* data = new MeshData(
+                SimTK::ContactGeometry::TriangleMesh::getAs(geometry));
+        data->bodyIndex = mesh.getFrame().getMobilizedBodyIndex();
+        data->X_BM = mesh.getFrame().findTransformInBaseFrame() *
+                mesh.getTransform();
+        return data;
+    };
+    m_mesh1.reset(createMeshData(getConnectee<ContactMesh>("mesh1")));
+    m_mesh2.reset(createMeshData(getConnectee<ContactMesh>("mesh2")));
+
+    // Create the threads once, rather than in every evaluation.
+    if (get_num_threads() == 1) {
+        m_threadPool.reset();
+    } else {
+        m_threadPool.reset(new ThreadPool(get_num_threads()));
+    }
+}
+
+int MeshElasticFoundationForce::getNumCandidateSprings() const {
+    int numCandidates = 0;
+    for (MeshData* data : {m_mesh1.get(), m_mesh2.get()}) {
+        if (!data) continue;
+        std::lock_guard<std::mutex> lock(data->candidatesMutex);
+        numCandidates += (int)data->candidates.size();
+    }
+    return numCandidates;
+}
+
+void MeshElasticFoundationForce::computeForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    calcSpringForces(state, &bodyForces);
+}
+
+double MeshElasticFoundationForce::computePotentialEnergy(
+        const SimTK::State& state) const {
+    return calcSpringForces(state, nullptr);
+}
+
+double MeshElasticFoundationForce::calcSpringForces(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>* bodyForces) const {
+    OPENSIM_THROW_IF_FRMOBJ(!m_mesh1.get() || !m_mesh2.get(), Exception,
+            "The force has not been added to a System; call "
+            "Model::initSystem() first.");
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    double potentialEnergy = 0;
+    std::vector<int> candidates;
+    std::vector<Spring> springs;
+    for (int imesh = 0; imesh < 2; ++imesh) {
+        MeshData& a = imesh == 0 ? *m_mesh1 : *m_mesh2;
+        const MeshData& b = imesh == 0 ? *m_mesh2 : *m_mesh1;
+        potentialEnergy +=
+                calcSpringForces(state, a, b, candidates, springs);
+        if (!bodyForces) continue;
+        const SimTK::MobilizedBody& bodyA = matter.getMobilizedBody(a.bodyIndex);
+        const SimTK::MobilizedBody& bodyB = matter.getMobilizedBody(b.bodyIndex);
+        for (const Spring& spring : springs) {
+            if (!spring.active) continue;
+            bodyA.applyForceToBodyPoint(
+                    state, spring.station, spring.force, *bodyForces);
+            bodyB.applyForceToBodyPoint(
+                    state, spring.otherStation, -spring.force, *bodyForces);
+        }
+    }
+    return potentialEnergy;
+}
+
+double MeshElasticFoundationForce::calcSpringForces(const SimTK::State& state,
+        MeshData& a, const MeshData& b, std::vector<int>& candidates,
+        std::vector<Spring>& springs) const {
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const SimTK::MobilizedBody& bodyA = matter.getMobilizedBody(a.bodyIndex);
+    const SimTK::MobilizedBody& bodyB = matter.getMobilizedBody(b.bodyIndex);
+    const SimTK::Transform X_GA = bodyA.getBodyTransform(state) * a.X_BM;
+    const SimTK::Transform X_GB = bodyB.getBodyTransform(state) * b.X_BM;
+    const SimTK::Transform X_BA = ~X_GB * X_GA;
+
+    // The candidates are selected and copied while holding the lock, in case
+    // the force is computed for several states concurrently; the springs are
+    // evaluated without it.
+    {
+        std::lock_guard<std::mutex> lock(a.candidatesMutex);
+        const double margin = get_candidate_margin();
+        if (a.needsNewCandidates(X_BA, margin)) {
+            a.selectCandidates(X_BA, b, margin);
+        }
+        candidates = a.candidates;
+    }
+    const int numCandidates = (int)candidates.size();
+    springs.resize(numCandidates);
+
+    const double stiffness = get_stiffness();
+    const double dissipation = get_dissipation();
+    const double staticFriction = get_static_friction();
+    const double dynamicFriction = get_dynamic_friction();
+    const double viscousFriction = get_viscous_friction();
+    const double transitionVelocity = get_transition_velocity();
+    // Both meshes have springs, so each spring represents half of the area
+    // of its face.
+    const double areaScale = 0.5;
+
+    const int numBlocks = (numCandidates + SpringsPerBlock - 1) / SpringsPerBlock;
+    std::vector<double> blockEnergies(numBlocks, 0.0);
+    auto calcBlock = [&](int iblock) {
+        const int end = std::min(numCandidates, (iblock + 1) * SpringsPerBlock);
+        for (int icand = iblock * SpringsPerBlock; icand < end; ++icand) {
+            const int ispring = candidates[icand];
+            Spring& spring = springs[icand];
+            spring.active = false;
+
+            // Find how much the spring is displaced.
+            const SimTK::Vec3& springInA = a.springPositions[ispring];
+            bool inside;
+            SimTK::UnitVec3 normal;
+            const SimTK::Vec3 nearestInB = b.geometry.findNearestPoint(
+                    X_BA * springInA, inside, normal);
+            if (!inside) continue;
+            const SimTK::Vec3 nearestPoint = X_GB * nearestInB;
+            const SimTK::Vec3 displacement = nearestPoint - X_GA * springInA;
+            const double distance = displacement.norm();
+            if (distance == 0) continue;
+            const SimTK::Vec3 forceDir = displacement / distance;
+
+            // The relative velocity of the bodies at the contact point.
+            spring.station = bodyA.findStationAtGroundPoint(state, nearestPoint);
+            spring.otherStation =
+                    bodyB.findStationAtGroundPoint(state, nearestPoint);
+            const SimTK::Vec3 v =
+                    bodyB.findStationVelocityInGround(state, spring.otherStation)
+                    - bodyA.findStationVelocityInGround(state, spring.station);
+            const double vnormal = SimTK::dot(v, forceDir);
+            const SimTK::Vec3 vtangent = v - vnormal * forceDir;
+
+            // The normal force, with dissipation.
+            const double area = areaScale * a.springAreas[ispring];
+            const double f = stiffness * area * distance *
+                             (1 + dissipation * vnormal);
+            spring.force = f > 0 ? f * forceDir : SimTK::Vec3(0);
+
+            // The friction force.
+            const double vslip = vtangent.norm();
+            if (f > 0 && vslip != 0) {
+                const double vrel = vslip / transitionVelocity;
+                const double ffriction = f * (std::min(vrel, 1.0) *
+                        (dynamicFriction + 2 * (staticFriction - dynamicFriction)
+                                / (1 + vrel * vrel)) + viscousFriction * vslip);
+                spring.force += ffriction * vtangent / vslip;
+            }
+            spring.active = true;
+            blockEnergies[iblock] +=
+                    stiffness * area * displacement.normSqr() / 2;
+        }
+    };
+    if (m_threadPool.get() && numBlocks > 1) {
+        m_threadPool->parallelFor(numBlocks, calcBlock);
+    } else {
+        for (int iblock = 0; iblock < numBlocks; ++iblock) calcBlock(iblock);
+    }
+
+    double potentialEnergy = 0;
+    for (double energy : blockEnergies) potentialEnergy += energy;
+    return potentialEnergy;
+}
+
+//==============================================================================
+//                                REPORTING
+//==============================================================================
+OpenSim::Array<std::string>
+MeshElasticFoundationForce::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (const std::string mesh : {"mesh1", "mesh2"}) {
+        const std::string frameName =
+                getConnectee<ContactMesh>(mesh).getFrame().getName();
+        labels.append(getName() + "." + frameName + ".force.X");
+        labels.append(getName() + "." + frameName + ".force.Y");
+        labels.append(getName() + "." + frameName + ".force.Z");
+        labels.append(getName() + "." + frameName + ".torque.X");
+        labels.append(getName() + "." + frameName + ".torque.Y");
+        labels.append(getName() + "." + frameName + ".torque.Z");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> MeshElasticFoundationForce::getRecordValues(
+        const SimTK::State& state) const {
+    OpenSim::Array<double> values(1);
+
+    const SimTK::Force& simtkForce =
+            getModel().getForceSubsystem().getForce(_index);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(0);
+    SimTK::Vector_<SimTK::Vec3> particleForces(0);
+    SimTK::Vector mobilityForces(0);
+    simtkForce.calcForceContribution(
+            state, bodyForces, particleForces, mobilityForces);
+
+    for (const std::string mesh : {"mesh1", "mesh2"}) {
+        const auto index = getConnectee<ContactMesh>(mesh)
+                .getFrame().getMobilizedBodyIndex();
+        const SimTK::SpatialVec& bodyForce = bodyForces(index);
+        SimTK::Vec3 forces = bodyForce[1];
+        SimTK::Vec3 torques = bodyForce[0];
+        values.append(3, &forces[0]);
+        values.append(3, &torques[0]);
+    }
+    return values;
+}
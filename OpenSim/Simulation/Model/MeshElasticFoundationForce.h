@@ -0,0 +1,175 @@
+#ifndef OPENSIM_MESH_ELASTIC_FOUNDATION_FORCE_H_
+#define OPENSIM_MESH_ELASTIC_FOUNDATION_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  MeshElasticFoundationForce.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include "Force.h"
+#include "ContactMesh.h"
+
+#include <memory>
+#include <vector>
+
+namespace OpenSim {
+
+class ThreadPool;
+
+//==============================================================================
+//                     MESH ELASTIC FOUNDATION FORCE
+//==============================================================================
+/** An elastic foundation contact model between two ContactMesh%es that
+detects contact itself instead of through Simbody's
+SimTK::GeneralContactSubsystem, for meshes with many faces.
+
+As in ElasticFoundationForce, there is a spring at the center of each face of
+each mesh. A spring that is inside the other mesh pushes the meshes apart with
+a force `stiffness*area*depth*(1 + dissipation*v_n)`, where `area` is half the
+area of the face (both meshes have springs), `depth` is the distance from the
+spring to the nearest point on the surface of the other mesh, and `v_n` is the
+normal approach velocity; friction is as in ElasticFoundationForce. This
+force produces the same results as an ElasticFoundationForce whose
+ContactParameters (with the same values) list both meshes.
+
+Contact detection is faster for large meshes:
+- The faces (and so the springs) of each mesh are stored in a
+  bounding-volume hierarchy (in the frame of the mesh, as the meshes are
+  rigid). The hierarchy of one mesh is traversed against that of the other:
+  a group of springs that is far from the surface of the other mesh is either
+  entirely inside or entirely outside the other mesh, which is decided by
+  testing a single point, so only the springs near the other mesh's surface
+  are examined individually.
+- This selection is made with the distances enlarged by the
+  candidate_margin, and is reused as long as the meshes move less than the
+  margin relative to each other, which is typical of consecutive integration
+  steps.
+- If num_threads is not 1, the selected springs are evaluated in parallel
+  when there are many of them, by a pool of threads that the force creates
+  when it is added to the system and keeps for its lifetime. The default is
+  1, since this force is often evaluated by tools (e.g., AnalyzeTool,
+  InverseDynamicsTool, EnsembleSimulator) or Moco solvers that already use a
+  thread for each copy of the model.
+
+The meshes should be closed and water-tight. */
+class OSIMSIMULATION_API MeshElasticFoundationForce : public Force {
+OpenSim_DECLARE_CONCRETE_OBJECT(MeshElasticFoundationForce, Force);
+public:
+//==============================================================================
+// PROPERTIES
+//==============================================================================
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness of the springs per unit area (N/m^3), "
+            "default is 0.");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient (s/m), default is 0.");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction (s/m), default is 0.");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "Slip velocity (creep) at which peak static friction occurs, "
+            "default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(candidate_margin, double,
+            "The distance by which the bounding spheres of the springs of a "
+            "mesh are enlarged when selecting the springs that may be inside "
+            "the other mesh; the selection is reused while the meshes move "
+            "less than this distance relative to each other. Default is "
+            "0.005 (m).");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "The number of threads used to evaluate the springs when many "
+            "springs may be in contact. A value less than 1 uses the number "
+            "of hardware threads. Default is 1.");
+
+//==============================================================================
+// SOCKETS
+//==============================================================================
+    OpenSim_DECLARE_SOCKET(mesh1, ContactMesh,
+            "The first mesh participating in this contact.");
+    OpenSim_DECLARE_SOCKET(mesh2, ContactMesh,
+            "The second mesh participating in this contact.");
+
+//==============================================================================
+// PUBLIC METHODS
+//==============================================================================
+    MeshElasticFoundationForce();
+    MeshElasticFoundationForce(const std::string& name,
+            const ContactMesh& mesh1, const ContactMesh& mesh2);
+
+    /** The number of springs that were evaluated the last time the force
+    was computed, for both meshes; that is, the number of springs that were
+    selected as possibly inside the other mesh. */
+    int getNumCandidateSprings() const;
+
+    //--------------------------------------------------------------------------
+    // REPORTING
+    //--------------------------------------------------------------------------
+    /// Obtain names of the quantities (column labels) of the force values to
+    /// be reported. The order is the three forces (XYZ) and three torques
+    /// (XYZ) applied on the body of mesh1 followed by the three forces (XYZ)
+    /// and three torques (XYZ) applied on the body of mesh2. Forces and
+    /// torques are expressed in the ground frame.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    /// Obtain the values to be reported that correspond to the labels.
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+    double computePotentialEnergy(const SimTK::State& state) const override;
+
+private:
+    // INITIALIZATION
+    void constructProperties();
+
+    struct MeshData;
+    struct Spring;
+    // Evaluate the springs of both meshes; if bodyForces is not null, apply
+    // the spring forces to it. Returns the potential energy of the springs.
+    double calcSpringForces(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>* bodyForces) const;
+    // Evaluate the springs of mesh `a` that are inside mesh `b`; the
+    // candidate springs of `a` are copied to `candidates`.
+    double calcSpringForces(const SimTK::State& state, MeshData& a,
+            const MeshData& b, std::vector<int>& candidates,
+            std::vector<Spring>& springs) const;
+
+    // The springs and bounding-volume hierarchies of mesh1 and mesh2, created
+    // when the force is added to the system.
+    mutable SimTK::ResetOnCopy<std::shared_ptr<MeshData>> m_mesh1;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<MeshData>> m_mesh2;
+    // The threads used to evaluate the springs, if num_threads is not 1.
+    mutable SimTK::ResetOnCopy<std::shared_ptr<ThreadPool>> m_threadPool;
+
+//==============================================================================
+};  // END of class MeshElasticFoundationForce
+//==============================================================================
+//==============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MESH_ELASTIC_FOUNDATION_FORCE_H_
@@ -142,6 +142,43 @@ Model* Model::clone() const
     return clone;
 }
 
+Model* Model::fork(const SimTK::State& s) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), Exception,
+            "Expected the model to have a System; call initSystem() first.");
+    OPENSIM_THROW_IF_FRMOBJ(
+            s.getSystemTopologyStageVersion() !=
+                    getSystem().getSystemTopologyCacheVersion(),
+            Exception, "Expected a state of this model's System.");
+
+    // The copy is finalized and connected by buildSystem().
+    std::unique_ptr<Model> fork(new Model(*this));
+    fork->setUseVisualizer(false);
+    fork->buildSystem();
+
+    const SimTK::MultibodySystem& system = fork->getMultibodySystem();
+    system.invalidateSystemTopologyCache();
+    system.realizeTopology();
+
+    // The copy's System has the same topology as this model's System, so a
+    // copy of the state (including its allocations for the Model stage)
+    // is a valid state of the copy once it refers to the copy's topology.
+    // The later stages are realized again with the copy.
+    OPENSIM_THROW_IF_FRMOBJ(
+            s.getNumSubsystems() != system.getNumSubsystems(), Exception,
+            "Expected the state to have {} subsystems, but it has {}.",
+            system.getNumSubsystems(), s.getNumSubsystems());
+    SimTK::State& forkState = fork->_workingState;
+    forkState = s;
+    forkState.setSystemTopologyStageVersion(
+            system.getSystemTopologyCacheVersion());
+    forkState.invalidateAllCacheAtOrAbove(Stage::Instance);
+    system.realize(forkState, Stage::Instance);
+
+    fork->createAssemblySolver(forkState);
+    return fork.release();
+}
+
 //_____________________________________________________________________________
 /*
  * Override default implementation by object to intercept and fix the XML node
@@ -997,6 +1034,8 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
     //Analyses are not Components so add them after legit 
     //Components have been wired-up correctly.
     mutableThis->updAnalysisSet().setModel(*mutableThis);
+    // Quantities cached for the analyses refer to the previous system.
+    mutableThis->_analysisCache.reset();
 
     // Reset the vector of all controls' defaults
     mutableThis->_defaultControls.resize(0);
@@ -1423,6 +1462,14 @@ int Model::getNumAnalyses() const
 
 
 
+//_____________________________________________________________________________
+AnalysisCache& Model::updAnalysisCache() const
+{
+    if (!_analysisCache)
+        const_cast<Model*>(this)->_analysisCache.reset(
+                new AnalysisCache(*this));
+    return *_analysisCache;
+}
 //_____________________________________________________________________________
 /**
  * Add an analysis to the model.
@@ -29,6 +29,7 @@
 #include <OpenSim/Common/Units.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
+#include <OpenSim/Simulation/Model/AnalysisCache.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/BodySet.h>
 #include <OpenSim/Simulation/Model/ComponentSet.h>
@@ -293,6 +294,24 @@ public:
     /** Model clone() override that invokes finalizeFromProperties() 
         on a default copy constructed Model, prior to returning the Model. */
     Model* clone() const override;
+
+    /** Create a copy of this model that is ready to use, with its System
+    built and its working state (see getWorkingState()) set to a copy of
+    the values (time, continuous state variables, and discrete variables) in
+    `s`, a state of this model. This is faster than clone() followed by
+    initSystem(), as it does not finalize the copy twice, and it does not
+    initialize the working state from the properties of the copy nor assemble
+    it. It is intended for creating copies of a model for each thread, e.g.:
+    @code
+    std::unique_ptr<Model> copy(model.fork(state));
+    SimTK::State& copyState = copy->updWorkingState();
+    @endcode
+    The copy does not use a visualizer. This model must have a System (see
+    initSystem()) that is up to date with its properties; the files of contact
+    meshes are parsed only once (see MeshCache).
+    @throws Exception if this model does not have a System or if `s` is not
+    a state of this model's System. */
+    Model* fork(const SimTK::State& s) const;
     
     const std::string& getConcreteClassName() const override
     {   return getClassName(); }
@@ -885,6 +904,12 @@ public:
 
     AnalysisSet& updAnalysisSet() {return _analysisSet; }
     const AnalysisSet& getAnalysisSet() const {return _analysisSet; }
+#ifndef SWIG
+    /** Quantities shared by the analyses of this model within a time step
+    (see AnalysisCache). The cache is created on first use, is emptied when
+    the system is created, and is not copied with the model. */
+    AnalysisCache& updAnalysisCache() const;
+#endif
 
     ContactGeometrySet& updContactGeometrySet() { return upd_ContactGeometrySet(); }
     const ContactGeometrySet& getContactGeometrySet() const { return get_ContactGeometrySet(); }
@@ -1195,6 +1220,10 @@ private:
     // when the Model is copied.
     SimTK::ResetOnCopy<std::unique_ptr<AssemblySolver>> _assemblySolver;
 
+    // Quantities shared by the analyses of the model within a time step.
+    // Like the AssemblySolver, this depends on the system and is not copied.
+    SimTK::ResetOnCopy<std::unique_ptr<AnalysisCache>> _analysisCache;
+
     // Model controls as a shared pool (Vector) of individual Actuator controls
     SimTK::MeasureIndex   _modelControlsIndex;
     // Default values pooled from Actuators upon system creation.
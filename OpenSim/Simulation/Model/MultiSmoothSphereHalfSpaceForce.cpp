@@ -0,0 +1,343 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  MultiSmoothSphereHalfSpaceForce.cpp                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MultiSmoothSphereHalfSpaceForce.h"
+#include "Model.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+//=============================================================================
+//  MULTI SMOOTH SPHERE HALF SPACE FORCE
+//=============================================================================
+// Uses default (compiler-generated) destructor, copy constructor, copy
+// assignment operator.
+
+// Default constructor.
+MultiSmoothSphereHalfSpaceForce::MultiSmoothSphereHalfSpaceForce() {
+    constructProperties();
+}
+
+MultiSmoothSphereHalfSpaceForce::MultiSmoothSphereHalfSpaceForce(
+        const std::string& name, const ContactHalfSpace& contactHalfSpace) {
+    constructProperties();
+    setName(name);
+    connectSocket_half_space(contactHalfSpace);
+}
+
+void MultiSmoothSphereHalfSpaceForce::constructProperties() {
+    constructProperty_contact_spheres();
+    constructProperty_stiffness(1.0);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_constant_contact_force(1e-5);
+    constructProperty_hertz_smoothing(300.0);
+    constructProperty_hunt_crossley_smoothing(50.0);
+}
+
+void MultiSmoothSphereHalfSpaceForce::addContactSphere(
+        const std::string& path) {
+    updProperty_contact_spheres().appendValue(path);
+}
+
+const ContactSphere& MultiSmoothSphereHalfSpaceForce::getContactSphere(
+        int index) const {
+    OPENSIM_THROW_IF_FRMOBJ(index < 0 || index >= (int)m_spheres.size(),
+            IndexOutOfRange, (size_t)index, 0,
+            m_spheres.empty() ? 0 : m_spheres.size() - 1);
+    return *m_spheres[index];
+}
+
+void MultiSmoothSphereHalfSpaceForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+
+    OPENSIM_THROW_IF_FRMOBJ(
+        (SimTK::isNaN(get_transition_velocity()) ||
+                get_transition_velocity() <= 0),
+        InvalidPropertyValue, getProperty_transition_velocity().getName(),
+        "Transition velocity must be greater than zero");
+    OPENSIM_THROW_IF_FRMOBJ(
+        (SimTK::isNaN(get_constant_contact_force()) ||
+                get_constant_contact_force() < 0),
+        InvalidPropertyValue, getProperty_constant_contact_force().getName(),
+        "Constant contact force cannot be less than zero");
+}
+
+void MultiSmoothSphereHalfSpaceForce::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    m_spheres.clear();
+    for (int i = 0; i < getProperty_contact_spheres().size(); ++i) {
+        // As in ElasticFoundationForce, a sphere in the model's
+        // ContactGeometrySet can also be given by its name.
+        const std::string& path = get_contact_spheres(i);
+        const ContactSphere* sphere = nullptr;
+        if (model.hasComponent<ContactSphere>(path)) {
+            sphere = &model.getComponent<ContactSphere>(path);
+        } else {
+            sphere = &model.getComponent<ContactSphere>(
+                    "./contactgeometryset/" + path);
+        }
+        m_spheres.emplace_back(sphere);
+    }
+}
+
+void MultiSmoothSphereHalfSpaceForce::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    m_sphereBodies.clear();
+    m_sphereLocations.clear();
+    m_sphereRadii.clear();
+    for (const auto& sphere : m_spheres) {
+        m_sphereBodies.push_back(sphere->getFrame().getMobilizedBodyIndex());
+        m_sphereLocations.push_back(
+                sphere->getFrame().findTransformInBaseFrame() *
+                sphere->get_location());
+        m_sphereRadii.push_back(sphere->getRadius());
+    }
+
+    const auto& halfSpace = getConnectee<ContactHalfSpace>("half_space");
+    m_halfSpaceBody = halfSpace.getFrame().getMobilizedBodyIndex();
+    m_halfSpaceFrame = halfSpace.getFrame().findTransformInBaseFrame() *
+                       halfSpace.getTransform();
+
+    this->_sphereForcesCV = addCacheVariable("sphere_forces", SphereForces(),
+            SimTK::Stage::Velocity);
+}
+
+void MultiSmoothSphereHalfSpaceForce::computeForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    const SphereForces& sf = getSphereForces(state);
+
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const SimTK::MobilizedBody& halfSpaceBody =
+            matter.getMobilizedBody(m_halfSpaceBody);
+    for (int i = 0; i < sf.forces.size(); ++i) {
+        matter.getMobilizedBody(m_sphereBodies[i]).applyForceToBodyPoint(
+                state, sf.sphereStations[i], sf.forces[i], bodyForces);
+        halfSpaceBody.applyForceToBodyPoint(
+                state, sf.halfSpaceStations[i], -sf.forces[i], bodyForces);
+    }
+}
+
+void MultiSmoothSphereHalfSpaceForce::calcSphereForces(
+        const SimTK::State& state, SimTK::Vector_<SimTK::Vec3>& forces,
+        SimTK::Vector_<SimTK::Vec3>& points) const {
+    const SphereForces& sf = getSphereForces(state);
+    forces = sf.forces;
+    points = sf.points;
+}
+
+void MultiSmoothSphereHalfSpaceForce::calcSphereForceDerivatives(
+        const SimTK::State& state,
+        SimTK::Vector_<SimTK::Mat33>& dForce_dPosition,
+        SimTK::Vector_<SimTK::Mat33>& dForce_dVelocity) const {
+    SphereForces sf;
+    calcSphereForces(state, sf, &dForce_dPosition, &dForce_dVelocity);
+}
+
+const MultiSmoothSphereHalfSpaceForce::SphereForces&
+MultiSmoothSphereHalfSpaceForce::getSphereForces(
+        const SimTK::State& state) const {
+    if (isCacheVariableValid(state, _sphereForcesCV)) {
+        return getCacheVariableValue(state, _sphereForcesCV);
+    }
+    SphereForces& sf = updCacheVariableValue(state, _sphereForcesCV);
+    calcSphereForces(state, sf, nullptr, nullptr);
+    markCacheVariableValid(state, _sphereForcesCV);
+    return sf;
+}
+
+void MultiSmoothSphereHalfSpaceForce::calcSphereForces(
+        const SimTK::State& state, SphereForces& sf,
+        SimTK::Vector_<SimTK::Mat33>* dForce_dPosition,
+        SimTK::Vector_<SimTK::Mat33>* dForce_dVelocity) const {
+    const int numSpheres = (int)m_sphereBodies.size();
+    OPENSIM_THROW_IF_FRMOBJ(numSpheres != (int)m_spheres.size(), Exception,
+            "The force has not been added to a System; call "
+            "Model::initSystem() first.");
+    // These keep their memory once they have the right size.
+    sf.forces.resize(numSpheres);
+    sf.points.resize(numSpheres);
+    sf.sphereStations.resize(numSpheres);
+    sf.halfSpaceStations.resize(numSpheres);
+    sf.indentation.resize(numSpheres);
+    sf.indentationRate.resize(numSpheres);
+    sf.tangentVelocity.resize(numSpheres);
+    if (dForce_dPosition) dForce_dPosition->resize(numSpheres);
+    if (dForce_dVelocity) dForce_dVelocity->resize(numSpheres);
+
+    // Gather the indentation, the indentation rate, and the tangential
+    // velocity of each sphere. The normal points out of the half space,
+    // which contains the points with x > 0 in its frame.
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const SimTK::MobilizedBody& halfSpaceBody =
+            matter.getMobilizedBody(m_halfSpaceBody);
+    const SimTK::Transform X_GH =
+            halfSpaceBody.getBodyTransform(state) * m_halfSpaceFrame;
+    const SimTK::Vec3 normal = X_GH.R() * SimTK::Vec3(-1, 0, 0);
+    for (int i = 0; i < numSpheres; ++i) {
+        const SimTK::MobilizedBody& sphereBody =
+                matter.getMobilizedBody(m_sphereBodies[i]);
+        const double radius = m_sphereRadii[i];
+        const SimTK::Vec3 center = sphereBody.findStationLocationInGround(
+                state, m_sphereLocations[i]);
+        sf.indentation[i] = radius - SimTK::dot(center - X_GH.p(), normal);
+        // The point halfway between the surfaces of the sphere and of the
+        // half space.
+        sf.points[i] = center - (radius - 0.5 * sf.indentation[i]) * normal;
+        sf.sphereStations[i] =
+                sphereBody.findStationAtGroundPoint(state, sf.points[i]);
+        sf.halfSpaceStations[i] =
+                halfSpaceBody.findStationAtGroundPoint(state, sf.points[i]);
+        const SimTK::Vec3 velocity =
+                sphereBody.findStationVelocityInGround(
+                        state, sf.sphereStations[i])
+                - halfSpaceBody.findStationVelocityInGround(
+                        state, sf.halfSpaceStations[i]);
+        const double normalVelocity = SimTK::dot(velocity, normal);
+        sf.indentationRate[i] = -normalVelocity;
+        sf.tangentVelocity[i] = velocity - normalVelocity * normal;
+    }
+
+    // Evaluate the contact model for all spheres.
+    const double stiffness = get_stiffness();
+    const double dissipation = get_dissipation();
+    const double staticFriction = get_static_friction();
+    const double dynamicFriction = get_dynamic_friction();
+    const double viscousFriction = get_viscous_friction();
+    const double transitionVelocity = get_transition_velocity();
+    const double cf = get_constant_contact_force();
+    const double bd = get_hertz_smoothing();
+    const double bv = get_hunt_crossley_smoothing();
+    const double k = 0.5 * std::pow(stiffness, 2.0 / 3.0);
+    const double deltaFriction = staticFriction - dynamicFriction;
+    const SimTK::Mat33 tangentProjection = SimTK::Mat33(1) - normal * ~normal;
+    for (int i = 0; i < numSpheres; ++i) {
+        const double x = sf.indentation[i];
+        const double xdot = sf.indentationRate[i];
+
+        // Smoothed Hertz force.
+        const double hertzScale =
+                (4.0 / 3.0) * k * std::sqrt(m_sphereRadii[i] * k);
+        const double aux = x * x + cf;
+        const double fH = hertzScale * std::pow(aux, 0.75);
+        const double tanhHertz = std::tanh(bd * x);
+        const double hertzSmoothing = 0.5 + 0.5 * tanhHertz;
+        const double fHd = fH * hertzSmoothing;
+
+        // Smoothed Hunt-Crossley force.
+        const double damping = 1 + 1.5 * dissipation * xdot;
+        const double tanhHuntCrossley =
+                std::tanh(bv * (xdot + 2.0 / (3.0 * dissipation)));
+        const double huntCrossleySmoothing = 0.5 + 0.5 * tanhHuntCrossley;
+        const double fn = fHd * damping * huntCrossleySmoothing;
+
+        // Friction force.
+        const SimTK::Vec3& vt = sf.tangentVelocity[i];
+        const double vslip = std::sqrt(vt.normSqr() + cf);
+        const double vrel = vslip / transitionVelocity;
+        const double stribeck =
+                dynamicFriction + 2 * deltaFriction / (1 + vrel * vrel);
+        const double mu = std::min(vrel, 1.0) * stribeck
+                          + viscousFriction * vslip;
+        const SimTK::Vec3 slipDirection =
+                vslip > 0 ? SimTK::Vec3(vt / vslip) : SimTK::Vec3(0);
+        const SimTK::Vec3 forceDirection = normal - mu * slipDirection;
+        sf.forces[i] = fn * forceDirection;
+
+        if (!dForce_dPosition) continue;
+        const double dfH_dx = 1.5 * hertzScale * x * std::pow(aux, -0.25);
+        const double dfHd_dx = dfH_dx * hertzSmoothing
+                + fH * 0.5 * bd * (1 - tanhHertz * tanhHertz);
+        const double dfn_dx = dfHd_dx * damping * huntCrossleySmoothing;
+        const double dfn_dxdot = fHd *
+                (1.5 * dissipation * huntCrossleySmoothing +
+                        damping * 0.5 * bv *
+                                (1 - tanhHuntCrossley * tanhHuntCrossley));
+        const double dstribeck_dvrel =
+                -4 * deltaFriction * vrel / SimTK::square(1 + vrel * vrel);
+        const double dmu_dvslip = (vrel < 1
+                ? stribeck + vrel * dstribeck_dvrel
+                : dstribeck_dvrel) / transitionVelocity + viscousFriction;
+
+        // The indentation decreases, and the indentation rate decreases, as
+        // the sphere moves along the normal.
+        (*dForce_dPosition)[i] = -dfn_dx * forceDirection * ~normal;
+        SimTK::Mat33 dSlipDirection_dv(0);
+        if (vslip > 0) {
+            dSlipDirection_dv = tangentProjection / vslip
+                    - vt * ~vt / (vslip * vslip * vslip);
+        }
+        (*dForce_dVelocity)[i] = -dfn_dxdot * forceDirection * ~normal
+                - fn * dmu_dvslip * slipDirection * ~slipDirection
+                - fn * mu * dSlipDirection_dv;
+    }
+}
+
+//=============================================================================
+//  REPORTING
+//=============================================================================
+OpenSim::Array<std::string>
+MultiSmoothSphereHalfSpaceForce::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (int i = 0; i < getProperty_contact_spheres().size(); ++i) {
+        const std::string prefix =
+                getName() + "." + getContactSphere(i).getName();
+        labels.append(prefix + ".force.X");
+        labels.append(prefix + ".force.Y");
+        labels.append(prefix + ".force.Z");
+        labels.append(prefix + ".torque.X");
+        labels.append(prefix + ".torque.Y");
+        labels.append(prefix + ".torque.Z");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> MultiSmoothSphereHalfSpaceForce::getRecordValues(
+        const SimTK::State& state) const {
+    OpenSim::Array<double> values(1);
+
+    const SphereForces& sf = getSphereForces(state);
+    const SimTK::Vector_<SimTK::Vec3>& forces = sf.forces;
+    const SimTK::Vector_<SimTK::Vec3>& points = sf.points;
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    for (int i = 0; i < forces.size(); ++i) {
+        const SimTK::Vec3 origin = matter.getMobilizedBody(m_sphereBodies[i])
+                .getBodyOriginLocation(state);
+        SimTK::Vec3 force = forces[i];
+        SimTK::Vec3 torque = SimTK::cross(points[i] - origin, forces[i]);
+        values.append(3, &force[0]);
+        values.append(3, &torque[0]);
+    }
+    return values;
+}
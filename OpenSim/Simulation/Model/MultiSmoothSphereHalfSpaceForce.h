@@ -0,0 +1,211 @@
+#ifndef OPENSIM_MULTI_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
+#define OPENSIM_MULTI_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  MultiSmoothSphereHalfSpaceForce.h                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include "Force.h"
+#include "ContactHalfSpace.h"
+#include "ContactSphere.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+/** The contact model of SmoothSphereHalfSpaceForce between a single half
+space and any number of spheres, evaluated for all spheres at once. A model
+of a foot often has many contact spheres that touch the same ground and share
+the same contact parameters; one MultiSmoothSphereHalfSpaceForce replaces a
+SmoothSphereHalfSpaceForce for each sphere and gives the same forces.
+
+All spheres use the contact parameters of this force, and the radius and
+location of their ContactSphere. The half space is connected through the
+`half_space` socket, and the spheres are listed (by their paths in the model)
+in the `contact_spheres` property.
+
+Each evaluation gathers the locations and velocities of all spheres and then
+evaluates the smooth Hertz, Hunt-Crossley, and friction terms in one loop
+over arrays, without a Simbody force element per sphere; the arrays are kept
+in a cache variable, so an evaluation does not allocate memory. The force on
+each sphere, and its partial derivatives with respect to the position and
+velocity of the sphere relative to the half space, are also available
+directly (see calcSphereForces() and calcSphereForceDerivatives()); the Moco
+contact goals (e.g., MocoContactTrackingGoal) use the forces to track the
+forces of individual spheres.
+
+@see SmoothSphereHalfSpaceForce */
+class OSIMSIMULATION_API MultiSmoothSphereHalfSpaceForce : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(MultiSmoothSphereHalfSpaceForce, Force);
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(contact_spheres, std::string,
+            "Paths to the ContactSphere components in contact with the half "
+            "space.");
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness constant (i.e., plain strain modulus), "
+            "default is 1 (N/m^2)");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "The transition velocity, default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(constant_contact_force, double,
+            "The constant that enforces non-null derivatives, "
+            "default is 1e-5 (N).");
+    OpenSim_DECLARE_PROPERTY(hertz_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hertz force. The larger the "
+            "steeper the transition but the worse for optimization, "
+            "default is 300.");
+    OpenSim_DECLARE_PROPERTY(hunt_crossley_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hunt-Crossley force. The larger "
+            "the steeper the transition but the worse for optimization, "
+            "default is 50.");
+
+    //=========================================================================
+    // SOCKETS
+    //=========================================================================
+    OpenSim_DECLARE_SOCKET(half_space, ContactHalfSpace,
+            "The half-space participating in this contact.");
+
+    //=========================================================================
+    // PUBLIC METHODS
+    //=========================================================================
+    MultiSmoothSphereHalfSpaceForce();
+    MultiSmoothSphereHalfSpaceForce(const std::string& name,
+            const ContactHalfSpace& contactHalfSpace);
+
+    /// Add a sphere, given its path in the model (e.g.,
+    /// "/contactgeometryset/heel").
+    void addContactSphere(const std::string& path);
+    int getNumContactSpheres() const {
+        return getProperty_contact_spheres().size();
+    }
+    /// The sphere at the given index of the contact_spheres property. The
+    /// model's connections must be finalized.
+    const ContactSphere& getContactSphere(int index) const;
+
+    /// The force that the half space applies to each sphere and the point (on
+    /// the sphere's surface, halfway into the penetration) at which it is
+    /// applied, both expressed in ground; the opposite force is applied to
+    /// the half space at the same point. The state must be realized to
+    /// Velocity.
+    void calcSphereForces(const SimTK::State& state,
+            SimTK::Vector_<SimTK::Vec3>& forces,
+            SimTK::Vector_<SimTK::Vec3>& points) const;
+
+    /// The partial derivatives of the force on each sphere (see
+    /// calcSphereForces()) with respect to the position of the sphere's
+    /// center, and with respect to the velocity of the point of application,
+    /// both relative to the half space and expressed in ground. The state
+    /// must be realized to Velocity.
+    void calcSphereForceDerivatives(const SimTK::State& state,
+            SimTK::Vector_<SimTK::Mat33>& dForce_dPosition,
+            SimTK::Vector_<SimTK::Mat33>& dForce_dVelocity) const;
+
+    //=========================================================================
+    // REPORTING
+    //=========================================================================
+    /// Obtain names of the quantities (column labels) of the force values to
+    /// be reported. For each sphere, the order is the three forces (XYZ)
+    /// applied to the sphere, and the three torques (XYZ) that these forces
+    /// apply to the sphere's body about its origin. Forces and torques are
+    /// expressed in the ground frame; the half space receives the opposite of
+    /// the sum of these forces.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    /// Obtain the values to be reported that correspond to the labels. The
+    /// values are expressed in the ground frame.
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+private:
+    // INITIALIZATION
+    void constructProperties();
+
+    // The forces on the spheres, the points at which they are applied (in
+    // ground and in the bodies of the sphere and of the half space), and the
+    // arrays used to compute them.
+    struct SphereForces {
+        SimTK::Vector_<SimTK::Vec3> forces;
+        SimTK::Vector_<SimTK::Vec3> points;
+        SimTK::Vector_<SimTK::Vec3> sphereStations;
+        SimTK::Vector_<SimTK::Vec3> halfSpaceStations;
+        std::vector<double> indentation;
+        std::vector<double> indentationRate;
+        std::vector<SimTK::Vec3> tangentVelocity;
+        friend std::ostream& operator<<(std::ostream& o,
+                const SphereForces& sf) {
+            o << "MultiSmoothSphereHalfSpaceForce::SphereForces: forces="
+              << sf.forces << " points=" << sf.points;
+            return o;
+        }
+    };
+
+    // The forces for the state, computed once per realization to Velocity.
+    const SphereForces& getSphereForces(const SimTK::State& state) const;
+    // Compute the forces on the spheres and their points of application and,
+    // if the pointers are not null, the derivatives of the forces.
+    void calcSphereForces(const SimTK::State& state, SphereForces& sf,
+            SimTK::Vector_<SimTK::Mat33>* dForce_dPosition,
+            SimTK::Vector_<SimTK::Mat33>* dForce_dVelocity) const;
+
+    mutable CacheVariable<SphereForces> _sphereForcesCV;
+
+    SimTK::ResetOnCopy<std::vector<SimTK::ReferencePtr<const ContactSphere>>>
+            m_spheres;
+
+    // The bodies of the spheres, the locations of their centers in the
+    // bodies, and their radii, gathered when the force is added to the
+    // system.
+    mutable SimTK::ResetOnCopy<std::vector<SimTK::MobilizedBodyIndex>>
+            m_sphereBodies;
+    mutable SimTK::ResetOnCopy<std::vector<SimTK::Vec3>> m_sphereLocations;
+    mutable SimTK::ResetOnCopy<std::vector<double>> m_sphereRadii;
+    mutable SimTK::ResetOnCopy<SimTK::MobilizedBodyIndex> m_halfSpaceBody;
+    // The frame of the half space in its body.
+    mutable SimTK::ResetOnCopy<SimTK::Transform> m_halfSpaceFrame;
+
+//=============================================================================
+}; // END of class MultiSmoothSphereHalfSpaceForce
+//=============================================================================
+//=============================================================================
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MULTI_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
@@ -94,6 +94,50 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
 }
 
 
+Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints, once for
+    // each coordinate
+    std::vector<Vector> couplings;
+    couplings.reserve(coordinates.size());
+    for (const Coordinate* coord : coordinates) {
+        couplings.push_back(computeCouplingVector(s_ma, *coord));
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    Matrix momentArms((int)paths.size(), (int)coordinates.size());
+    Vector pathDependentMobilityForces(s_ma.getNU());
+    for (int i = 0; i < (int)paths.size(); ++i) {
+        // zero out all the forces
+        _bodyForces *= 0;
+        _generalizedForces = 0;
+        pathDependentMobilityForces = 0;
+
+        // apply a tension of unity to the bodies of the path
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+                pathDependentMobilityForces);
+
+        // f = ~J(q) * F, as in solve() for a single coordinate.
+        getModel().getMultibodySystem().getMatterSubsystem()
+            .multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+                    _generalizedForces);
+        _generalizedForces += pathDependentMobilityForces;
+
+        for (int j = 0; j < (int)coordinates.size(); ++j) {
+            momentArms(i, j) = ~couplings[j]*_generalizedForces;
+        }
+    }
+    return momentArms;
+}
+
 
 double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
                               const Array<PointForceDirection *> &pfds) const
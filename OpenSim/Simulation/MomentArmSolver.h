@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class GeometryPath;
@@ -83,6 +85,23 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+#ifndef SWIG
+    /** Solve for the effective moment-arms of several GeometryPaths about
+        several coordinates. The constraint coupling of each coordinate and
+        the generalized forces of each path are computed once, so this is
+        faster than calling solve() for each (path, coordinate) pair, and
+        gives the same results.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return ma                  moment-arms, with a row for each path and a
+                                column for each coordinate
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+#endif
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -54,6 +54,9 @@ template <class T> class Reference_ : public Object {
     // METHODS
     //=============================================================================
 public:
+    /** The type of the values of the Reference signals. */
+    typedef T ValueType;
+
     //--------------------------------------------------------------------------
     // CONSTRUCTION
     //--------------------------------------------------------------------------
@@ -47,8 +47,10 @@
 #include "Model/CoordinateLimitForce.h"
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
+#include "Model/MeshElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/MultiSmoothSphereHalfSpaceForce.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -242,8 +244,10 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( ContactSphere() );
     Object::registerType( CoordinateLimitForce() );
     Object::registerType( SmoothSphereHalfSpaceForce() );
+    Object::registerType( MultiSmoothSphereHalfSpaceForce() );
     Object::registerType( HuntCrossleyForce() );
     Object::registerType( ElasticFoundationForce() );
+    Object::registerType( MeshElasticFoundationForce() );
     Object::registerType( HuntCrossleyForce::ContactParameters() );
     Object::registerType( HuntCrossleyForce::ContactParametersSet() );
     Object::registerType( ElasticFoundationForce::ContactParameters() );
@@ -420,13 +420,15 @@ TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
     const auto& gravity = model.getGravity();
     const auto& timeVec = accelTableEffort.getIndependentColumn();
     TimeSeriesTableVec3 accelTableIMU(timeVec);
+    SimTK::State state;
+    if (statesTraj.getSize()) state = statesTraj.front();
     for (const auto& framePath : framePaths) {
         std::string label = framePath + "|linear_acceleration";
         const auto& col = accelTableEffort.getDependentColumn(label);
         const auto& frame = model.getComponent<PhysicalFrame>(framePath);
         SimTK::Vector_<SimTK::Vec3> colIMU(col.size());
         for (int i = 0; i < (int)timeVec.size(); ++i) {
-            const auto& state = statesTraj.get(i);
+            statesTraj.copyTimeAndY(i, state);
             model.realizeAcceleration(state);
             SimTK::Vec3 accelIMU = ground.expressVectorInAnotherFrame(
                     state, col[i] - gravity, frame);
@@ -315,10 +315,14 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         }
     }
 
-    // Loop through the states trajectory to create the report.
+    // Loop through the states trajectory to create the report. The
+    // trajectory is compact, so we reuse a single working state rather than
+    // creating (and copying) a full state for each time.
+    SimTK::State state;
+    if (statesTraj.getSize()) state = statesTraj.front();
     for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
         // Get the current state.
-        auto state = statesTraj[itime];
+        statesTraj.copyTimeAndY(itime, state);
 
         // Enforce any SimTK::Motion's included in the model.
         model.getSystem().prescribe(state);
@@ -28,33 +28,142 @@
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 
+StatesTrajectory::StatesTrajectory() = default;
+
+StatesTrajectory::StatesTrajectory(const StatesTrajectory& other) {
+    *this = other;
+}
+
+StatesTrajectory::StatesTrajectory(StatesTrajectory&& other) {
+    *this = std::move(other);
+}
+
+StatesTrajectory& StatesTrajectory::operator=(const StatesTrajectory& other) {
+    if (this == &other) return *this;
+    m_compact = other.m_compact;
+    m_times = other.m_times;
+    m_numY = other.m_numY;
+    m_y = other.m_y;
+    m_templateState = other.m_templateState;
+    m_states.clear();
+    m_states.reserve(other.m_states.size());
+    for (const auto& state : other.m_states) {
+        m_states.emplace_back(new SimTK::State(*state));
+    }
+    // States of a compact trajectory are recreated on demand.
+    m_cachedStates.clear();
+    return *this;
+}
+
+StatesTrajectory& StatesTrajectory::operator=(StatesTrajectory&& other) {
+    if (this == &other) return *this;
+    m_compact = other.m_compact;
+    m_times = std::move(other.m_times);
+    m_numY = other.m_numY;
+    m_y = std::move(other.m_y);
+    m_templateState = std::move(other.m_templateState);
+    m_states = std::move(other.m_states);
+    m_cachedStates = std::move(other.m_cachedStates);
+    return *this;
+}
+
+StatesTrajectory::~StatesTrajectory() = default;
+
 size_t StatesTrajectory::getSize() const {
-    return m_states.size();
+    return m_times.size();
+}
+
+const SimTK::State& StatesTrajectory::operator[](size_t index) const {
+    if (!m_compact) return *m_states[index];
+
+    std::lock_guard<std::mutex> lock(m_statesMutex);
+    for (const auto& cached : m_cachedStates) {
+        if (cached.first == index) return *cached.second;
+    }
+    // Keep at most MaxCachedStates states; once the cache is full, reuse the
+    // state that was created the longest time ago.
+    std::unique_ptr<SimTK::State> state;
+    if (m_cachedStates.size() < MaxCachedStates) {
+        state.reset(new SimTK::State(*m_templateState));
+    } else {
+        state = std::move(m_cachedStates.front().second);
+        m_cachedStates.pop_front();
+    }
+    copyTimeAndY(index, *state);
+    m_cachedStates.emplace_back(index, std::move(state));
+    return *m_cachedStates.back().second;
+}
+
+void StatesTrajectory::copyTimeAndY(size_t index, SimTK::State& state) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+            static_cast<unsigned>(getSize() - 1));
+    if (m_compact) {
+        OPENSIM_THROW_IF(state.getNY() != m_numY, Exception,
+                "Expected the state to have {} continuous state variables, "
+                "but it has {}.", m_numY, state.getNY());
+        state.setTime(m_times[index]);
+        SimTK::Vector& y = state.updY();
+        const double* values = m_y.data() + index * m_numY;
+        for (int i = 0; i < m_numY; ++i) y[i] = values[i];
+    } else {
+        const SimTK::State& source = *m_states[index];
+        OPENSIM_THROW_IF(state.getNY() != source.getNY(), Exception,
+                "Expected the state to have {} continuous state variables, "
+                "but it has {}.", source.getNY(), state.getNY());
+        state.setTime(source.getTime());
+        state.updY() = source.getY();
+    }
 }
 
 void StatesTrajectory::clear() {
+    m_times.clear();
+    m_numY = 0;
+    m_y.clear();
+    m_templateState.reset();
     m_states.clear();
+    m_cachedStates.clear();
+}
+
+void StatesTrajectory::setCompact(bool compact) {
+    OPENSIM_THROW_IF(getSize() != 0, Exception,
+            "Cannot change whether a StatesTrajectory is compact unless it "
+            "is empty.");
+    m_compact = compact;
 }
 
 void StatesTrajectory::append(const SimTK::State& state) {
-    if (!m_states.empty()) {
+    if (!m_times.empty()) {
 
-        SimTK_APIARGCHECK2_ALWAYS(m_states.back().getTime() <= state.getTime(),
+        SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
                 "StatesTrajectory", "append",
                 "New state's time (%f) must be equal to or greater than the "
                 "time for the last state in the trajectory (%f).",
-                state.getTime(), m_states.back().getTime()
+                state.getTime(), m_times.back()
                 );
 
         // We assume the trajectory (before appending) is already consistent,
         // so we only need to check consistency with a single state in the
         // trajectory.
-        OPENSIM_THROW_IF(!m_states.back().isConsistent(state),
+        const SimTK::State& last =
+                m_compact ? *m_templateState : *m_states.back();
+        OPENSIM_THROW_IF(!last.isConsistent(state),
           InconsistentState, state.getTime());
     }
-    m_states.push_back(state);
+    m_times.push_back(state.getTime());
+    if (m_compact) {
+        if (!m_templateState) {
+            m_templateState = std::make_shared<const SimTK::State>(state);
+            m_numY = state.getNY();
+        }
+        const SimTK::Vector& y = state.getY();
+        for (int i = 0; i < m_numY; ++i) m_y.push_back(y[i]);
+    } else {
+        m_states.emplace_back(new SimTK::State(state));
+    }
 }
 
 bool StatesTrajectory::hasIntegrity() const {
@@ -65,6 +174,12 @@ bool StatesTrajectory::isNondecreasingInTime() const {
     // An empty or size-1 trajectory necessarily has nondecreasing times.
     if (getSize() <= 1) return true;
 
+    // The states of a compact trajectory cannot be edited, so we do not need
+    // to create them.
+    if (m_compact) {
+        return std::is_sorted(m_times.begin(), m_times.end());
+    }
+
     for (unsigned itime = 1; itime < getSize(); ++itime) {
 
         if (get(itime).getTime() < get(itime - 1).getTime()) {
@@ -79,6 +194,9 @@ bool StatesTrajectory::isConsistent() const {
     // An empty or size-1 trajectory is necessarily consistent.
     if (getSize() <= 1) return true;
 
+    // All states of a compact trajectory are created from the same state.
+    if (m_compact) return true;
+
     const auto& state0 = operator[](0);
 
     for (unsigned itime = 1; itime < getSize(); ++itime) {
@@ -139,9 +257,17 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
+    // For a compact trajectory, use a single working state rather than
+    // creating a state for each time.
+    std::unique_ptr<SimTK::State> workingState;
+    if (m_compact && getSize()) {
+        workingState.reset(new SimTK::State(*m_templateState));
+    }
+
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
-        const auto& state = get(itime);
+        if (workingState) copyTimeAndY(itime, *workingState);
+        const auto& state = workingState ? *workingState : get(itime);
         TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
 
         // Get each state variable's value.
@@ -166,9 +292,10 @@ StatesTrajectory StatesTrajectory::createFromStatesStorage(
         const Storage& sto,
         bool allowMissingColumns,
         bool allowExtraColumns,
-        bool assemble) {
+        bool assemble,
+        bool compact) {
     return createFromStatesTable(model, sto.exportToTable(),
-            allowMissingColumns, allowExtraColumns, assemble);
+            allowMissingColumns, allowExtraColumns, assemble, compact);
 }
 
 StatesTrajectory StatesTrajectory::createFromStatesTable(
@@ -176,13 +303,15 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
         const TimeSeriesTable& table,
         bool allowMissingColumns,
         bool allowExtraColumns,
-        bool assemble) {
+        bool assemble,
+        bool compact) {
 
     // Assemble the required objects.
     // ==============================
 
     // This is what we'll return.
     StatesTrajectory states;
+    states.setCompact(compact);
 
     // Make a copy of the model so that we can get a corresponding state.
     Model localModel(model);
@@ -248,7 +377,9 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // ===================
 
     // Reserve the memory we'll need to fit all the states.
-    states.m_states.reserve(table.getNumRows());
+    states.m_times.reserve(table.getNumRows());
+    states.m_y.reserve(table.getNumRows() * state.getNY());
+    if (!compact) states.m_states.reserve(table.getNumRows());
 
     // Working memory for state. Initialize so that missing columns end up as
     // NaN.
@@ -274,7 +405,9 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
             localModel.assemble(state);
         }
 
-        // Make a copy of the edited state and put it in the trajectory.
+        // Put a copy of the edited state in the trajectory (if compact, only
+        // the time and continuous state variables are copied, except for the
+        // first state).
         states.append(state);
     }
 
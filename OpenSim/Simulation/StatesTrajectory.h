@@ -23,6 +23,11 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include <OpenSim/Common/Exception.h>
@@ -138,11 +143,45 @@ class Model;
  *               << std::endl;
  * }
  * @endcode
+ *
+ * \subsection st_compact Compact trajectories
+ * By default, the trajectory holds a full copy of each SimTK::State, including
+ * its cache. For long trajectories of large models, this can consume a lot of
+ * memory, and appending each state requires an expensive copy. A *compact*
+ * trajectory (see setCompact()) instead stores only the time and continuous
+ * state variables (Y) of each state, in contiguous arrays, along with a single
+ * copy of the first appended state. The rest of the contents of every state
+ * in the trajectory (discrete variables, modeling options, etc.) come from
+ * that first state. A SimTK::State is created for an index only when it is
+ * accessed (e.g., through get() or by iterating), and the trajectory keeps
+ * only the MaxCachedStates most recently created states, so a reference to a
+ * state of a compact trajectory remains valid only until MaxCachedStates
+ * other states have been created. Copy the state if you need to keep it
+ * longer. To visit every state without creating them, use copyTimeAndY()
+ * with a single working state:
+ * @code{.cpp}
+ * SimTK::State state = states.front();
+ * for (size_t i = 0; i < states.getSize(); ++i) {
+ *     states.copyTimeAndY(i, state);
+ *     model.realizeReport(state);
+ * }
+ * @endcode
+ * createFromStatesTable() can create a compact trajectory (see its `compact`
+ * argument), since it only restores the continuous state variables anyway.
  */
 class OSIMSIMULATION_API StatesTrajectory {
 public:
+    /** The maximum number of states a compact trajectory keeps after they are
+     * accessed (see \ref st_compact). */
+    static constexpr size_t MaxCachedStates = 16;
+
     /** Create an empty trajectory of states. */
-    StatesTrajectory() {}
+    StatesTrajectory();
+    StatesTrajectory(const StatesTrajectory&);
+    StatesTrajectory(StatesTrajectory&&);
+    StatesTrajectory& operator=(const StatesTrajectory&);
+    StatesTrajectory& operator=(StatesTrajectory&&);
+    ~StatesTrajectory();
 
     /** The number of SimTK::State%s in the trajectory. */
     size_t getSize() const;
@@ -159,36 +198,108 @@ public:
      * model.getStateVariableValue(state, "knee/flexion/value");
      * @endcode
      * This function does not check if the index is larger than the size of
-     * the trajectory; see get() if you want this check. */
-    const SimTK::State& operator[](size_t index) const {
-        return m_states[index];
-    }
+     * the trajectory; see get() if you want this check. For a compact
+     * trajectory, the reference remains valid only until MaxCachedStates
+     * other states have been accessed (see \ref st_compact). */
+    const SimTK::State& operator[](size_t index) const;
     /** Get a const reference to the state at a given index in the trajectory.
 
      * @throws IndexOutOfRange If the index is greater than the size of the
      *                         trajectory.
      */
     const SimTK::State& get(size_t index) const {
-        try {
-            return m_states.at(index);
-        } catch (const std::out_of_range&) {
-            OPENSIM_THROW(IndexOutOfRange, index, 0, 
-                          static_cast<unsigned>(m_states.size() - 1));
-        }
+        OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+                static_cast<unsigned>(getSize() - 1));
+        return operator[](index);
     }
     /** Get a const reference to the first state in the trajectory. */
     const SimTK::State& front() const { 
-        return m_states.front();
+        return operator[](0);
     }
     /** Get a const reference to the last state in the trajectory. */
     const SimTK::State& back() const { 
-        return m_states.back();
+        return operator[](getSize() - 1);
     }
+    /** Set the time and continuous state variables (Y) of the provided state
+     * to those of the state at the given index, leaving the rest of the
+     * provided state unchanged. The provided state must have the same number
+     * of continuous state variables as the states in the trajectory (e.g., it
+     * could be a copy of front()). For a compact trajectory, this does not
+     * create a SimTK::State for the given index, which makes this the
+     * cheapest way to visit every state of a long trajectory.
+     * @throws IndexOutOfRange If the index is greater than the size of the
+     *                         trajectory.
+     */
+    void copyTimeAndY(size_t index, SimTK::State& state) const;
     /// @}
     
+#ifndef SWIG
     /** Iterator type that does not allow modifying the trajectory.
      * Most users do not need to understand what this is. */
-    typedef std::vector<SimTK::State>::const_iterator const_iterator;
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef SimTK::State value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SimTK::State* pointer;
+        typedef const SimTK::State& reference;
+
+        const_iterator() = default;
+        const_iterator(const StatesTrajectory* trajectory, size_t index)
+                : m_trajectory(trajectory), m_index(index) {}
+
+        reference operator*() const { return (*m_trajectory)[m_index]; }
+        pointer operator->() const { return &(*m_trajectory)[m_index]; }
+        reference operator[](difference_type n) const {
+            return (*m_trajectory)[m_index + n];
+        }
+
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) { auto it = *this; ++m_index; return it; }
+        const_iterator& operator--() { --m_index; return *this; }
+        const_iterator operator--(int) { auto it = *this; --m_index; return it; }
+        const_iterator& operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const {
+            return const_iterator(m_trajectory, m_index + n);
+        }
+        const_iterator operator-(difference_type n) const {
+            return const_iterator(m_trajectory, m_index - n);
+        }
+        difference_type operator-(const const_iterator& other) const {
+            return (difference_type)m_index - (difference_type)other.m_index;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_trajectory == other.m_trajectory &&
+                   m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+        bool operator<(const const_iterator& other) const {
+            return m_index < other.m_index;
+        }
+        bool operator>(const const_iterator& other) const {
+            return m_index > other.m_index;
+        }
+        bool operator<=(const const_iterator& other) const {
+            return m_index <= other.m_index;
+        }
+        bool operator>=(const const_iterator& other) const {
+            return m_index >= other.m_index;
+        }
+
+    private:
+        const StatesTrajectory* m_trajectory = nullptr;
+        size_t m_index = 0;
+    };
 
     /** A helper type to allow using range for loops over a subset of the
      * trajectory. */
@@ -199,22 +310,36 @@ public:
 
     /** Iterator pointing to first SimTK::State; does not allow modifying the
      * states. Allows using this class in a range for loop. */
-    const_iterator begin() const { return m_states.cbegin(); }
+    const_iterator begin() const { return const_iterator(this, 0); }
     /** Iterator pointing past the end of the trajectory. Allows using this
      * class in a range for loop. */
-    const_iterator end() const { return m_states.cend(); }
+    const_iterator end() const { return const_iterator(this, getSize()); }
     /// @}
+#endif
 
     /// @name Modify the contents of the trajectory
     /// @{
-    /** Clear all the states in the trajectory. */
+    /** Clear all the states in the trajectory. This does not change whether
+     * the trajectory is compact. */
     void clear();
+    /** Store only the time and continuous state variables of each appended
+     * state, and take the rest of the contents of every state from the first
+     * appended state (see \ref st_compact). Use this only if the discrete
+     * state variables and modeling options do not change over the
+     * trajectory.
+     * @throws Exception If the trajectory is not empty. */
+    void setCompact(bool compact);
+    /** Whether the trajectory stores only the time and continuous state
+     * variables of each state (see setCompact()). */
+    bool isCompact() const { return m_compact; }
     /** Append a SimTK::State to this trajectory.
      * This function ensures that the time in the new SimTK::State is greater
      * than or equal to the time in the last SimTK::State in the trajectory.
      *
      * The state that ends up in the trajectory is a deep copy of the one
-     * passed in.
+     * passed in. If the trajectory is compact, only the time and continuous
+     * state variables of the state are kept (the first appended state is
+     * kept in full).
      */
     void append(const SimTK::State& state);
     /// @}
@@ -291,7 +416,25 @@ public:
 
 private:
 
-    std::vector<SimTK::State> m_states;
+    bool m_compact = false;
+    // The time of each state.
+    std::vector<double> m_times;
+
+    // If compact, the continuous state variables of all states, stored
+    // contiguously (m_numY values per state), and the state that supplies the
+    // rest of the contents of every state.
+    int m_numY = 0;
+    std::vector<double> m_y;
+    std::shared_ptr<const SimTK::State> m_templateState;
+
+    // If not compact, a copy of each appended state (empty if compact).
+    std::vector<std::unique_ptr<SimTK::State>> m_states;
+    // If compact, the most recently accessed states and their indices, oldest
+    // first (at most MaxCachedStates).
+    mutable std::deque<std::pair<size_t, std::unique_ptr<SimTK::State>>>
+            m_cachedStates;
+    // Guards the creation of states in a compact trajectory.
+    mutable std::mutex m_statesMutex;
 
 public:
 
@@ -397,7 +540,8 @@ public:
             const Storage& sto,
             bool allowMissingColumns = false,
             bool allowExtraColumns = false,
-            bool assemble = false);
+            bool assemble = false,
+            bool compact = false);
 
     /** Create a partial trajectory of States from a states table.
      * The resulting StatesTrajectory will restore continuous state
@@ -442,6 +586,11 @@ public:
      *      model's assembly accuracy, and therefore assembling could
      *      alter the trajectory and cause inconsistency between coordinate
      *      values and speeds.
+     * @param compact Create a compact trajectory, which stores only the
+     *      time and continuous state variables of each state (see
+     *      \ref st_compact). This uses much less memory for long
+     *      trajectories, but a reference to a state in the trajectory
+     *      remains valid only until other states are accessed.
      *
      * Here is how you might use this function in python:
      * @code{.py}
@@ -470,7 +619,8 @@ public:
             const TimeSeriesTable& table,
             bool allowMissingColumns = false,
             bool allowExtraColumns = false,
-            bool assemble = false);
+            bool assemble = false,
+            bool compact = false);
 
     /** Convenience form of createFromStatesStorage() that takes the path to a
      * Storage file instead of a Storage object. This convenience form uses the
@@ -26,6 +26,10 @@
 using namespace OpenSim;
 
 
+StatesTrajectoryReporter::StatesTrajectoryReporter() {
+    constructProperty_compact(false);
+}
+
 void StatesTrajectoryReporter::clear() {
     m_states.clear();
 }
@@ -43,5 +47,8 @@ void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state)
 */
 
 void StatesTrajectoryReporter::implementReport(const SimTK::State& state) const {
+    if (m_states.getSize() == 0 && m_states.isCompact() != get_compact()) {
+        m_states.setCompact(get_compact());
+    }
     m_states.append(state);
 }
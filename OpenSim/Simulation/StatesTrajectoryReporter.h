@@ -41,6 +41,14 @@ class OSIMSIMULATION_API StatesTrajectoryReporter : public AbstractReporter {
 OpenSim_DECLARE_CONCRETE_OBJECT(StatesTrajectoryReporter, AbstractReporter);
 
 public:
+    OpenSim_DECLARE_PROPERTY(compact, bool,
+        "Store only the time and continuous state variables of each reported "
+        "state; discrete variables and modeling options are taken from the "
+        "first reported state (default: false). See "
+        "StatesTrajectory::setCompact().");
+
+    StatesTrajectoryReporter();
+
     /** Access the accumulated states. */
     const StatesTrajectory& getStates() const; 
     /** Clear the accumulated states. */ 
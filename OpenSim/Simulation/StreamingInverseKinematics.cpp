@@ -0,0 +1,284 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  StreamingInverseKinematics.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingInverseKinematics.h"
+
+#include "BufferedOrientationsReference.h"
+#include "InverseKinematicsSolver.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+//=============================================================================
+// LATENCY HISTOGRAM
+//=============================================================================
+StreamingInverseKinematics::LatencyHistogram::LatencyHistogram(
+        double binWidth, int numBins)
+        : m_binWidth(binWidth), m_counts(std::max(numBins, 1), 0) {
+    OPENSIM_THROW_IF(binWidth <= 0, Exception,
+            "Expected a positive bin width, but got {}.", binWidth);
+}
+
+void StreamingInverseKinematics::LatencyHistogram::record(double latency) {
+    const int numBins = (int)m_counts.size();
+    const int bin = latency < numBins * m_binWidth
+                            ? std::max(0, (int)(latency / m_binWidth))
+                            : numBins - 1;
+    ++m_counts[bin];
+    ++m_numSamples;
+    m_sum += latency;
+    m_max = std::max(m_max, latency);
+}
+
+void StreamingInverseKinematics::LatencyHistogram::clear() {
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_numSamples = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+double StreamingInverseKinematics::LatencyHistogram::getMean() const {
+    return m_numSamples ? m_sum / m_numSamples : SimTK::NaN;
+}
+
+double StreamingInverseKinematics::LatencyHistogram::calcPercentile(
+        double fraction) const {
+    if (m_numSamples == 0) return SimTK::NaN;
+    const double target = fraction * m_numSamples;
+    int cumulative = 0;
+    for (int i = 0; i < (int)m_counts.size(); ++i) {
+        cumulative += m_counts[i];
+        if (cumulative >= target) return (i + 1) * m_binWidth;
+    }
+    return m_counts.size() * m_binWidth;
+}
+
+//=============================================================================
+// STREAMING INVERSE KINEMATICS
+//=============================================================================
+StreamingInverseKinematics::StreamingInverseKinematics(const Model& model,
+        const TimeSeriesTable_<SimTK::Rotation>& initialOrientations,
+        int capacity)
+        : m_model(new Model(model)),
+          m_initialOrientations(initialOrientations),
+          m_frames(std::max(capacity, 1)), m_results(std::max(capacity, 1)) {
+    OPENSIM_THROW_IF(m_initialOrientations.getNumRows() == 0, Exception,
+            "Expected at least one row of initial orientations.");
+    // Only the first row is needed to assemble the model.
+    const double firstTime =
+            m_initialOrientations.getIndependentColumn().front();
+    m_initialOrientations.trim(firstTime, firstTime);
+
+    m_model->setUseVisualizer(false);
+    m_model->finalizeFromProperties();
+    for (const auto& coord : m_model->getComponentList<Coordinate>()) {
+        m_coordinateNames.push_back(coord.getName());
+    }
+}
+
+StreamingInverseKinematics::~StreamingInverseKinematics() {
+    try {
+        stop();
+    } catch (...) {
+    }
+}
+
+void StreamingInverseKinematics::start() {
+    OPENSIM_THROW_IF(m_thread.joinable(), Exception,
+            "The engine is already running; call stop() first.");
+    m_stop = false;
+    m_failed = false;
+    m_exception = nullptr;
+    m_latencyHistogram.clear();
+    m_numSolved = 0;
+    m_numInterpolated = 0;
+    m_numDropped = 0;
+    m_numRejected = 0;
+    m_numDiscarded = 0;
+
+    // Assemble on the calling thread so that errors in the model or the
+    // data are reported by start().
+    m_state = m_model->initSystem();
+    m_reference = std::make_shared<BufferedOrientationsReference>(
+            m_initialOrientations);
+    m_reference->set_default_weight(1.0);
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    m_solver.reset(new InverseKinematicsSolver(
+            *m_model, nullptr, m_reference, coordinateReferences));
+    m_solver->setAccuracy(m_accuracy);
+    const double firstTime =
+            m_initialOrientations.getIndependentColumn().front();
+    m_state.setTime(firstTime);
+    m_solver->assemble(m_state);
+    // From now on, each call to track() takes the next frame from the
+    // reference's queue.
+    m_solver->setAdvanceTimeFromReference(true);
+    m_lastPushedTime = firstTime;
+
+    // The assembly is published without a latency, since the first frame
+    // was not pushed and the assembly is much slower than tracking.
+    Result first;
+    first.time = firstTime;
+    first.coordinateValues.resize((int)m_coordinateNames.size());
+    int i = 0;
+    for (const auto& coord : m_model->getComponentList<Coordinate>()) {
+        first.coordinateValues[i++] = coord.getValue(m_state);
+    }
+    ++m_numSolved;
+    if (!m_results.tryPush(first)) ++m_numDiscarded;
+
+    m_thread = std::thread(&StreamingInverseKinematics::run, this);
+}
+
+void StreamingInverseKinematics::stop() {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true);
+    m_framePushed.notify();
+    m_thread.join();
+    if (m_exception) {
+        std::exception_ptr exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+const StreamingInverseKinematics::LatencyHistogram&
+StreamingInverseKinematics::getLatencyHistogram() const {
+    OPENSIM_THROW_IF(m_thread.joinable(), Exception,
+            "The latency histogram is updated by the solver thread; call "
+            "stop() before reading it.");
+    return m_latencyHistogram;
+}
+
+bool StreamingInverseKinematics::pushFrame(double time,
+        const SimTK::RowVector_<SimTK::Rotation>& orientations) {
+    OPENSIM_THROW_IF(orientations.size() !=
+                             (int)m_initialOrientations.getNumColumns(),
+            Exception, "Expected {} orientations, but got {}.",
+            m_initialOrientations.getNumColumns(), orientations.size());
+    if (m_failed.load() || !(time > m_lastPushedTime)) {
+        ++m_numRejected;
+        return false;
+    }
+    Frame frame;
+    frame.time = time;
+    frame.orientations = orientations;
+    frame.pushTime = Clock::now();
+    if (!m_frames.tryPush(frame)) {
+        ++m_numRejected;
+        return false;
+    }
+    m_lastPushedTime = time;
+    m_framePushed.notify();
+    return true;
+}
+
+bool StreamingInverseKinematics::tryPopResult(Result& result) {
+    return m_results.tryPop(result);
+}
+
+void StreamingInverseKinematics::run() {
+    try {
+        Frame frame;
+        Frame next;
+        std::vector<Frame> skipped;
+        double lastTime = m_state.getTime();
+        SimTK::Vector lastValues((int)m_coordinateNames.size());
+        SimTK::Vector values((int)m_coordinateNames.size());
+        SimTK::Vector interpolatedValues((int)m_coordinateNames.size());
+        int i = 0;
+        for (const auto& coord : m_model->getComponentList<Coordinate>()) {
+            lastValues[i++] = coord.getValue(m_state);
+        }
+
+        while (true) {
+            // Read the flag before the queue so that frames pushed before
+            // stop() are still solved.
+            const bool stopping = m_stop.load();
+            if (!m_frames.tryPop(frame)) {
+                if (stopping) break;
+                m_framePushed.wait([this] {
+                    return !m_frames.empty() || m_stop.load();
+                });
+                continue;
+            }
+
+            // Skip to the most recent frame if this one has waited too long.
+            skipped.clear();
+            while (std::chrono::duration<double>(
+                           Clock::now() - frame.pushTime).count() >
+                            m_latencyBudget &&
+                    m_frames.tryPop(next)) {
+                skipped.push_back(std::move(frame));
+                frame = std::move(next);
+            }
+
+            solve(frame, values);
+            if (m_policy == LateFramePolicy::Interpolate) {
+                for (const auto& skippedFrame : skipped) {
+                    const double weight = (skippedFrame.time - lastTime) /
+                                          (frame.time - lastTime);
+                    interpolatedValues =
+                            lastValues + weight * (values - lastValues);
+                    ++m_numInterpolated;
+                    publish(skippedFrame, interpolatedValues, true);
+                }
+            } else {
+                m_numDropped += (int)skipped.size();
+            }
+            publish(frame, values, false);
+            lastTime = frame.time;
+            lastValues = values;
+        }
+    } catch (...) {
+        m_exception = std::current_exception();
+        m_failed.store(true);
+    }
+}
+
+void StreamingInverseKinematics::solve(
+        const Frame& frame, SimTK::Vector& coordinateValues) {
+    m_reference->putValues(frame.time, frame.orientations);
+    // Takes the frame from the reference and sets the time of the state.
+    m_solver->track(m_state);
+    int i = 0;
+    for (const auto& coord : m_model->getComponentList<Coordinate>()) {
+        coordinateValues[i++] = coord.getValue(m_state);
+    }
+    ++m_numSolved;
+}
+
+void StreamingInverseKinematics::publish(const Frame& frame,
+        const SimTK::Vector& coordinateValues, bool interpolated) {
+    Result result;
+    result.time = frame.time;
+    result.coordinateValues = coordinateValues;
+    result.interpolated = interpolated;
+    result.latency =
+            std::chrono::duration<double>(Clock::now() - frame.pushTime)
+                    .count();
+    m_latencyHistogram.record(result.latency);
+    if (!m_results.tryPush(result)) ++m_numDiscarded;
+}
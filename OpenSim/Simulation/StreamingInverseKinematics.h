@@ -0,0 +1,261 @@
+#ifndef OPENSIM_STREAMING_INVERSE_KINEMATICS_H_
+#define OPENSIM_STREAMING_INVERSE_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  StreamingInverseKinematics.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ * Author(s): The OpenSim Team                                                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+class BufferedOrientationsReference;
+class InverseKinematicsSolver;
+class Model;
+
+/** Solve inverse kinematics for a live stream of orientation (e.g., IMU)
+data on a dedicated thread.
+
+A producer thread (e.g., the thread that receives data from the sensors)
+passes each frame of orientations to pushFrame(). The solver thread feeds the
+frames to a BufferedOrientationsReference and calls
+InverseKinematicsSolver::track() for each of them, and publishes the
+resulting coordinate values, which a consumer thread obtains with
+tryPopResult(). Frames and results are passed between the threads through
+bounded lock-free queues (see RingBuffer), so neither the producer nor the
+consumer ever waits for the solver.
+
+The engine keeps up with the stream by bounding the latency of the frames it
+solves: if the oldest unsolved frame was pushed more than
+getLatencyBudget() seconds ago, the solver skips ahead to the most recent
+frame. The coordinate values of the skipped frames are either not published
+(LateFramePolicy::Drop) or linearly interpolated between the neighboring
+solved frames (LateFramePolicy::Interpolate). The latency of the result of
+each pushed frame, from pushFrame() to publication, is recorded in a
+histogram (see
+getLatencyHistogram()), with which one can verify that a model is solved in
+real time at the rate of the data.
+
+@code
+StreamingInverseKinematics engine(model, firstFrame);
+engine.setLatencyBudget(0.01); // 100 Hz
+engine.start();
+// On the producer thread:
+engine.pushFrame(time, orientations);
+// On the consumer thread:
+StreamingInverseKinematics::Result result;
+while (engine.tryPopResult(result)) { ... }
+// Once the stream ends:
+engine.stop();
+log_info("95th percentile latency: {} s",
+        engine.getLatencyHistogram().calcPercentile(0.95));
+@endcode
+
+The engine solves a copy of the model, so the provided model need not
+outlive the engine. The settings must be set before start().
+@ingroup simulationutil */
+class OSIMSIMULATION_API StreamingInverseKinematics {
+public:
+    enum class LateFramePolicy {
+        Drop,       ///< Do not publish results for skipped frames.
+        Interpolate ///< Interpolate the results of skipped frames.
+    };
+
+    /// The coordinate values for one frame of orientations.
+    struct Result {
+        double time = SimTK::NaN;
+        /// In the order of getCoordinateNames().
+        SimTK::Vector coordinateValues;
+        /// Time in seconds from pushFrame() to the publication of the result;
+        /// NaN for the result of the assembly in start(), which was not
+        /// pushed and is not recorded in the latency histogram.
+        double latency = SimTK::NaN;
+        /// Whether the result was interpolated instead of solved.
+        bool interpolated = false;
+    };
+
+    /// A histogram of latencies, in seconds, with bins of equal width. The
+    /// last bin also counts all latencies beyond the range of the histogram.
+    class OSIMSIMULATION_API LatencyHistogram {
+    public:
+        explicit LatencyHistogram(double binWidth = 1e-4, int numBins = 1000);
+        void record(double latency);
+        void clear();
+        double getBinWidth() const { return m_binWidth; }
+        const std::vector<int>& getCounts() const { return m_counts; }
+        int getNumSamples() const { return m_numSamples; }
+        double getMean() const;
+        double getMax() const { return m_max; }
+        /// The upper edge of the bin that contains the given fraction
+        /// (between 0 and 1) of the samples; NaN if there are no samples.
+        double calcPercentile(double fraction) const;
+
+    private:
+        double m_binWidth;
+        std::vector<int> m_counts;
+        int m_numSamples = 0;
+        double m_sum = 0;
+        double m_max = 0;
+    };
+
+    /// The names and the default weight (1) of the orientations are taken
+    /// from initialOrientations, whose first row is used to assemble the
+    /// model in start(). `capacity` is the number of frames and of results
+    /// that can be queued at a time.
+    StreamingInverseKinematics(const Model& model,
+            const TimeSeriesTable_<SimTK::Rotation>& initialOrientations,
+            int capacity = 1024);
+    /// Stops the solver thread. Exceptions from the solver thread are
+    /// discarded; call stop() first to handle them.
+    ~StreamingInverseKinematics();
+
+    StreamingInverseKinematics(const StreamingInverseKinematics&) = delete;
+    StreamingInverseKinematics& operator=(
+            const StreamingInverseKinematics&) = delete;
+
+    /// The maximum time, in seconds, that a frame may wait in the queue
+    /// before the solver skips to a more recent frame (default: 0.01).
+    void setLatencyBudget(double seconds) { m_latencyBudget = seconds; }
+    double getLatencyBudget() const { return m_latencyBudget; }
+
+    /// What to publish for skipped frames (default: Interpolate).
+    void setLateFramePolicy(LateFramePolicy policy) { m_policy = policy; }
+    LateFramePolicy getLateFramePolicy() const { return m_policy; }
+
+    /// The accuracy of the InverseKinematicsSolver (default: 1e-4).
+    void setAccuracy(double accuracy) { m_accuracy = accuracy; }
+    double getAccuracy() const { return m_accuracy; }
+
+    /// The names of the coordinates in Result::coordinateValues.
+    const std::vector<std::string>& getCoordinateNames() const
+    {   return m_coordinateNames; }
+
+    /// Assemble the model to the first row of the initial orientations,
+    /// publish the result, and start the solver thread.
+    /// @throws Exception if the engine is already running.
+    void start();
+    /// Solve the frames that are still queued, stop the solver thread, and
+    /// rethrow the first exception thrown on the solver thread, if any.
+    void stop();
+    /// Whether the solver thread is solving frames: it was started and
+    /// has neither been stopped nor failed.
+    bool isRunning() const { return m_thread.joinable() && !m_failed; }
+    /// Whether the solver thread stopped because of an exception, which
+    /// stop() rethrows. The engine no longer accepts frames until it is
+    /// stopped and started again.
+    bool hasFailed() const { return m_failed; }
+
+    /// Queue a frame of orientations, in the order of the initial
+    /// orientations. Only one thread may push frames. Returns false, and
+    /// rejects the frame, if the queue is full, if the frame is not later
+    /// than the previously pushed frame, or if the solver thread has failed
+    /// (see hasFailed()).
+    /// @throws Exception if the number of orientations is incorrect.
+    bool pushFrame(double time,
+            const SimTK::RowVector_<SimTK::Rotation>& orientations);
+
+    /// Obtain the oldest published result, unless there is none, in which
+    /// case this returns false. Only one thread may pop results. If results
+    /// are not popped, the solver discards new results once the queue is
+    /// full.
+    bool tryPopResult(Result& result);
+
+    /// @name Statistics
+    /// The frame counts can be read while the engine runs. The latency
+    /// histogram is written by the solver thread without synchronization, so
+    /// it can only be read while the engine is stopped.
+    /// @{
+    int getNumSolvedFrames() const { return m_numSolved; }
+    int getNumInterpolatedFrames() const { return m_numInterpolated; }
+    /// Frames skipped with LateFramePolicy::Drop.
+    int getNumDroppedFrames() const { return m_numDropped; }
+    /// Frames rejected by pushFrame().
+    int getNumRejectedFrames() const { return m_numRejected; }
+    /// Results discarded because the result queue was full.
+    int getNumDiscardedResults() const { return m_numDiscarded; }
+    /// The latencies of the results of the frames pushed since the last
+    /// start().
+    /// @throws Exception if the solver thread has not been stopped.
+    const LatencyHistogram& getLatencyHistogram() const;
+    /// @}
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Frame {
+        double time = SimTK::NaN;
+        SimTK::RowVector_<SimTK::Rotation> orientations;
+        Clock::time_point pushTime;
+    };
+
+    void run();
+    void solve(const Frame& frame, SimTK::Vector& coordinateValues);
+    void publish(const Frame& frame, const SimTK::Vector& coordinateValues,
+            bool interpolated);
+
+    std::unique_ptr<Model> m_model;
+    TimeSeriesTable_<SimTK::Rotation> m_initialOrientations;
+    std::vector<std::string> m_coordinateNames;
+
+    double m_latencyBudget = 0.01;
+    LateFramePolicy m_policy = LateFramePolicy::Interpolate;
+    double m_accuracy = 1e-4;
+
+    // Used only by the solver thread while the engine runs.
+    SimTK::State m_state;
+    std::shared_ptr<BufferedOrientationsReference> m_reference;
+    std::unique_ptr<InverseKinematicsSolver> m_solver;
+
+    RingBuffer<Frame> m_frames;
+    // Notified after each pushed frame and after the stop request.
+    IdleWaiter m_framePushed;
+    RingBuffer<Result> m_results;
+    // Accessed only by the producer.
+    double m_lastPushedTime = -SimTK::Infinity;
+
+    std::atomic<int> m_numSolved{0};
+    std::atomic<int> m_numInterpolated{0};
+    std::atomic<int> m_numDropped{0};
+    std::atomic<int> m_numRejected{0};
+    std::atomic<int> m_numDiscarded{0};
+    // Written by the solver thread while the engine runs.
+    LatencyHistogram m_latencyHistogram;
+
+    std::atomic<bool> m_stop{false};
+    // Set by the solver thread after it stores m_exception.
+    std::atomic<bool> m_failed{false};
+    std::exception_ptr m_exception;
+    std::thread m_thread;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STREAMING_INVERSE_KINEMATICS_H_
@@ -44,6 +44,8 @@
 #include <OpenSim/Simulation/Model/ContactSphere.h>
 #include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
 #include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
+#include <OpenSim/Simulation/Model/MeshCache.h>
+#include <OpenSim/Simulation/Model/MeshElasticFoundationForce.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
@@ -75,6 +77,8 @@ const static string mesh_files[] = {"sphere_10cm_radius.obj",
 int testBouncingBall(bool useMesh, const std::string mesh_filename="");
 int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh2);
 void compareHertzAndMeshContactResults();
+void testMeshCache();
+void testMeshElasticFoundationForce();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
 
@@ -94,6 +98,8 @@ int main()
         testBallToBallContact(true, false, true);
         testBallToBallContact(true, true, true); 
         compareHertzAndMeshContactResults();
+        testMeshCache();
+        testMeshElasticFoundationForce();
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
@@ -595,20 +601,218 @@ void testIntermediateFrames() {
     SimTK_TEST_EQ_TOL(stateWeld.getY(), stateIntermedFrameXY.getY(), 1e-10);
 }
 
+// Components that load the same mesh file, including those in copies of a
+// model, share one parsed mesh through the MeshCache.
+void testMeshCache() {
+    MeshCache::clear();
+    {
+        auto mesh1 = MeshCache::getMeshData(mesh_files[0]);
+        auto mesh2 = MeshCache::getMeshData(
+                Pathname::getAbsolutePathname(mesh_files[0]));
+        ASSERT(mesh1 == mesh2);
+        ASSERT(!mesh1->vertices.empty());
+
+        // Each call to createMesh() gives an independent copy of the mesh in
+        // the file.
+        PolygonalMesh fromFile;
+        fromFile.loadFile(mesh_files[0]);
+        const PolygonalMesh created = mesh1->createMesh();
+        ASSERT(created.getNumVertices() == fromFile.getNumVertices());
+        ASSERT(created.getNumFaces() == fromFile.getNumFaces());
+        for (int i = 0; i < fromFile.getNumVertices(); ++i) {
+            ASSERT(created.getVertexPosition(i) ==
+                   fromFile.getVertexPosition(i));
+        }
+        for (int i = 0; i < fromFile.getNumFaces(); ++i) {
+            ASSERT(created.getNumVerticesForFace(i) ==
+                   fromFile.getNumVerticesForFace(i));
+            for (int j = 0; j < fromFile.getNumVerticesForFace(i); ++j) {
+                ASSERT(created.getFaceVertex(i, j) ==
+                       fromFile.getFaceVertex(i, j));
+            }
+        }
+        ASSERT(!mesh1->createMesh().isSameHandle(created));
+
+        // createTriangleMesh() copies the TriangleMesh built when the file
+        // was loaded.
+        const SimTK::ContactGeometry::TriangleMesh fromPolygonalMesh(fromFile);
+        std::unique_ptr<SimTK::ContactGeometry::TriangleMesh> triangleMesh(
+                mesh1->createTriangleMesh());
+        ASSERT(triangleMesh->getNumVertices() ==
+               fromPolygonalMesh.getNumVertices());
+        ASSERT(triangleMesh->getNumFaces() == fromPolygonalMesh.getNumFaces());
+        ASSERT(triangleMesh.get() != mesh1->triangleMesh.get());
+
+        auto mesh3 = MeshCache::getMeshData(mesh_files[2]);
+        ASSERT(mesh3 != mesh1);
+        ASSERT(MeshCache::getNumMeshes() == 2);
+    }
+    // The meshes are freed when they are no longer used.
+    ASSERT(MeshCache::getNumMeshes() == 0);
+    ASSERT_THROW(OpenSim::Exception,
+            MeshCache::getMeshData("nonexistent_mesh_file.obj"));
 
+    Model model;
+    auto* ball = new OpenSim::Body("ball", mass, Vec3(0), Inertia(1));
+    model.addBody(ball);
+    model.addJoint(new FreeJoint("free", model.getGround(), *ball));
+    model.addContactGeometry(new ContactMesh(mesh_files[0], Vec3(0), Vec3(0),
+            *ball, "mesh"));
+    model.addContactGeometry(new ContactSphere(radius, Vec3(0),
+            model.getGround(), "sphere"));
+    auto* force = new ElasticFoundationForce();
+    force->addGeometry("mesh");
+    force->addGeometry("sphere");
+    model.addForce(force);
+    model.initSystem();
 
+    Model copy(model);
+    copy.initSystem();
+    ASSERT(MeshCache::getNumMeshes() == 1);
+}
 
+void testMeshElasticFoundationForce() {
+    // Two mesh balls, one fixed to ground and one free, with the same
+    // parameters for an ElasticFoundationForce and a
+    // MeshElasticFoundationForce.
+    Model model;
+    auto* ball = new OpenSim::Body("ball", mass, Vec3(0), Inertia(1));
+    model.addBody(ball);
+    model.addJoint(new FreeJoint("free", model.getGround(), *ball));
+    auto* mesh1 = new ContactMesh(mesh_files[0], Vec3(0), Vec3(0),
+            model.getGround(), "ball1");
+    auto* mesh2 = new ContactMesh(mesh_files[0], Vec3(0), Vec3(0.1, 0.2, 0),
+            *ball, "ball2");
+    model.addContactGeometry(mesh1);
+    model.addContactGeometry(mesh2);
+
+    const double stiffness = 1.0e6 / (2 * radius);
+    auto* contactParams = new OpenSim::ElasticFoundationForce::ContactParameters(
+            stiffness, 0.5, 0.9, 0.6, 0.1);
+    contactParams->addGeometry("ball1");
+    contactParams->addGeometry("ball2");
+    auto* elasticFoundation = new OpenSim::ElasticFoundationForce(contactParams);
+    elasticFoundation->setName("elastic_foundation");
+    model.addForce(elasticFoundation);
+
+    auto* meshForce = new MeshElasticFoundationForce("mesh_elastic_foundation",
+            *mesh1, *mesh2);
+    meshForce->set_stiffness(stiffness);
+    meshForce->set_dissipation(0.5);
+    meshForce->set_static_friction(0.9);
+    meshForce->set_dynamic_friction(0.6);
+    meshForce->set_viscous_friction(0.1);
+    model.addForce(meshForce);
+
+    SimTK::State& state = model.initSystem();
+
+    // The forces on the free ball from both forces must match, for small
+    // motions (reusing the candidate springs) and large motions.
+    auto compare = [&](double height, double speed) {
+        state.updQ()[3] = 0.01;
+        state.updQ()[4] = height;
+        state.updU()[3] = 0.2;
+        state.updU()[4] = speed;
+        model.realizeVelocity(state);
+        const Array<double> expected =
+                elasticFoundation->getRecordValues(state);
+        const Array<double> found = meshForce->getRecordValues(state);
+        ASSERT(expected.getSize() == 12 && found.getSize() == 12);
+        for (int i = 0; i < 12; ++i) {
+            ASSERT_EQUAL(expected[i], found[i],
+                    1e-8 * (1 + std::abs(expected[i])), __FILE__, __LINE__,
+                    "MeshElasticFoundationForce FAILED to match "
+                    "ElasticFoundationForce");
+        }
+        return expected[7];
+    };
+    double ballForce = 0;
+    for (double height = 2 * radius; height > 1.95 * radius;
+            height -= 1e-4) {
+        ballForce = compare(height, -0.1);
+    }
+    ASSERT(ballForce > 0);
+    compare(1.9 * radius, 0.3);
+    compare(1.5 * radius, 0);
+    compare(1.98 * radius, 0);
+
+    // Springs far from the other ball are not evaluated.
+    const int numFaces = 8704;
+    ASSERT(meshForce->getNumCandidateSprings() > 0);
+    ASSERT(meshForce->getNumCandidateSprings() < numFaces);
+    ASSERT(compare(3 * radius, 0) == 0);
+    ASSERT(meshForce->getNumCandidateSprings() == 0);
+
+    // Evaluate both forces in a sequence of small motions, as in a
+    // simulation, in which the selected springs are reused. The forces must
+    // match at every step and only the springs near the contact may be
+    // evaluated.
+    const int numEvaluations = 100;
+    std::vector<Array<double>> results[2];
+    int iforce = 0;
+    for (const OpenSim::Force* force :
+            {(const OpenSim::Force*)elasticFoundation,
+             (const OpenSim::Force*)meshForce}) {
+        for (int i = 0; i < numEvaluations; ++i) {
+            state.updQ()[4] = 1.96 * radius + 1e-5 * i;
+            model.realizeVelocity(state);
+            results[iforce].push_back(force->getRecordValues(state));
+        }
+        ++iforce;
+    }
+    for (int i = 0; i < numEvaluations; ++i) {
+        ASSERT(results[1][i][7] > 0);
+        for (int j = 0; j < 12; ++j) {
+            ASSERT_EQUAL(results[0][i][j], results[1][i][j],
+                    1e-8 * (1 + std::abs(results[0][i][j])), __FILE__,
+                    __LINE__, "MeshElasticFoundationForce FAILED to match "
+                    "ElasticFoundationForce in a sequence of motions");
+        }
+    }
+    ASSERT(meshForce->getNumCandidateSprings() < numFaces / 4);
 
+    // Evaluating the springs with a pool of threads gives the same results.
+    // The deep penetration makes enough candidates for several threads.
+    state.updQ()[4] = 1.5 * radius;
+    model.realizeVelocity(state);
+    const Array<double> serial = meshForce->getRecordValues(state);
+    {
+        Model threadedModel(model);
+        threadedModel.updComponent<MeshElasticFoundationForce>(
+                "/forceset/mesh_elastic_foundation").set_num_threads(3);
+        SimTK::State& threadedState = threadedModel.initSystem();
+        threadedState.updQ() = state.getQ();
+        threadedState.updU() = state.getU();
+        threadedModel.realizeVelocity(threadedState);
+        const auto& threadedForce =
+                threadedModel.getComponent<MeshElasticFoundationForce>(
+                        "/forceset/mesh_elastic_foundation");
+        for (int repeat = 0; repeat < 10; ++repeat) {
+            const Array<double> threaded =
+                    threadedForce.getRecordValues(threadedState);
+            ASSERT(threadedForce.getNumCandidateSprings() > 1024);
+            for (int j = 0; j < 12; ++j) {
+                ASSERT_EQUAL(serial[j], threaded[j],
+                        1e-10 * (1 + std::abs(serial[j])), __FILE__,
+                        __LINE__, "Threaded evaluation differs.");
+            }
+        }
+    }
 
-
-
-
-
-
-
-
-
-
-
-
-
+    // The force can be serialized.
+    model.print("testMeshElasticFoundationForce.osim");
+    Model deserialized("testMeshElasticFoundationForce.osim");
+    SimTK::State& deserializedState = deserialized.initSystem();
+    deserializedState.updQ() = state.getQ();
+    deserializedState.updU() = state.getU();
+    deserialized.realizeVelocity(deserializedState);
+    const Array<double> found =
+            deserialized.getComponent<MeshElasticFoundationForce>(
+                    "/forceset/mesh_elastic_foundation")
+                    .getRecordValues(deserializedState);
+    const Array<double> expected = meshForce->getRecordValues(state);
+    for (int i = 0; i < 12; ++i) {
+        ASSERT_EQUAL(expected[i], found[i], 1e-12 * (1 + std::abs(expected[i])),
+                __FILE__, __LINE__, "Deserialized force differs.");
+    }
+}
@@ -29,6 +29,7 @@
 //      3. ElasticFoundationForce
 //      4. HuntCrossleyForce
 //      5. SmoothSphereHalfSpaceForce
+//         MultiSmoothSphereHalfSpaceForce
 //      6. CoordinateLimitForce
 //      7. RotationalCoordinateLimitForce
 //      8. ExternalForce
@@ -66,6 +67,7 @@ void testExpressionBasedBushingForceRotational();
 void testElasticFoundation();
 void testHuntCrossleyForce();
 void testSmoothSphereHalfSpaceForce();
+void testMultiSmoothSphereHalfSpaceForce();
 void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
@@ -138,6 +140,12 @@ int main() {
         failures.push_back("testSmoothSphereHalfSpaceForce");
     }
 
+    try { testMultiSmoothSphereHalfSpaceForce(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testMultiSmoothSphereHalfSpaceForce");
+    }
+
     try { testCoordinateLimitForce(); }
     catch (const std::exception& e){
         cout << e.what() <<endl; failures.push_back("testCoordinateLimitForce");
@@ -1420,6 +1428,167 @@ void testSmoothSphereHalfSpaceForce()
     ASSERT(isEqual);
 }
 
+// A MultiSmoothSphereHalfSpaceForce must produce the same forces, and the same
+// accelerations, as one SmoothSphereHalfSpaceForce per sphere, and its
+// derivatives must match finite differences.
+void testMultiSmoothSphereHalfSpaceForce()
+{
+    using namespace SimTK;
+
+    Model model;
+    model.setGravity(gravity_vec);
+    auto* block = new OpenSim::Body("block", 2.0, Vec3(0), Inertia(0.1));
+    model.addBody(block);
+    auto* free = new FreeJoint("free", model.getGround(), *block);
+    model.addJoint(free);
+
+    auto* floor = new ContactHalfSpace(Vec3(0), Vec3(0, 0, -0.5 * Pi),
+            model.getGround(), "floor");
+    model.addContactGeometry(floor);
+    const std::vector<Vec3> locations{
+            Vec3(0.1, 0, 0), Vec3(-0.1, 0, 0.05), Vec3(0, 0, -0.1)};
+    const std::vector<double> radii{0.05, 0.04, 0.06};
+
+    auto* multi = new MultiSmoothSphereHalfSpaceForce("multi", *floor);
+    std::vector<SmoothSphereHalfSpaceForce*> singles;
+    for (int i = 0; i < (int)locations.size(); ++i) {
+        const std::string name = "sphere" + std::to_string(i);
+        auto* sphere =
+                new ContactSphere(radii[i], locations[i], *block, name);
+        model.addContactGeometry(sphere);
+        multi->addContactSphere(sphere->getAbsolutePathString());
+        auto* single = new SmoothSphereHalfSpaceForce(
+                "single" + std::to_string(i), *sphere, *floor);
+        singles.push_back(single);
+    }
+    for (auto* force : singles) {
+        force->set_stiffness(1e6);
+        force->set_dissipation(2.0);
+        force->set_static_friction(0.8);
+        force->set_dynamic_friction(0.6);
+        force->set_viscous_friction(0.1);
+        force->set_transition_velocity(0.2);
+        model.addForce(force);
+    }
+    multi->set_stiffness(1e6);
+    multi->set_dissipation(2.0);
+    multi->set_static_friction(0.8);
+    multi->set_dynamic_friction(0.6);
+    multi->set_viscous_friction(0.1);
+    multi->set_transition_velocity(0.2);
+    model.addForce(multi);
+
+    SimTK::State& state = model.initSystem();
+    ASSERT(multi->getNumContactSpheres() == 3);
+    ASSERT(&multi->getContactSphere(1) ==
+            &model.getComponent<ContactSphere>(
+                    "contactgeometryset/sphere1"));
+    ASSERT_THROW(OpenSim::IndexOutOfRange, multi->getContactSphere(3));
+
+    // Some spheres penetrate the floor, others do not.
+    const auto& tx = free->getCoordinate(FreeJoint::Coord::TranslationX);
+    const auto& ty = free->getCoordinate(FreeJoint::Coord::TranslationY);
+    const auto& tz = free->getCoordinate(FreeJoint::Coord::TranslationZ);
+    const auto& rx = free->getCoordinate(FreeJoint::Coord::Rotation1X);
+    const auto& rz = free->getCoordinate(FreeJoint::Coord::Rotation3Z);
+    tx.setValue(state, 0.2);
+    ty.setValue(state, 0.045);
+    tz.setValue(state, -0.1);
+    rx.setValue(state, 0.05);
+    rz.setValue(state, -0.1);
+    tx.setSpeedValue(state, 0.3);
+    ty.setSpeedValue(state, -0.1);
+    tz.setSpeedValue(state, 0.05);
+    rx.setSpeedValue(state, 0.5);
+    model.realizeVelocity(state);
+
+    const Array<double> multiValues = multi->getRecordValues(state);
+    ASSERT(multi->getRecordLabels().getSize() == 18);
+    ASSERT(multiValues.getSize() == 18);
+    for (int i = 0; i < (int)singles.size(); ++i) {
+        const Array<double> singleValues = singles[i]->getRecordValues(state);
+        for (int j = 0; j < 6; ++j) {
+            ASSERT_EQUAL(singleValues[j], multiValues[6 * i + j],
+                    1e-8 * (1 + std::abs(singleValues[j])), __FILE__,
+                    __LINE__, "Force and torque on sphere " +
+                    std::to_string(i) + " differ.");
+        }
+    }
+
+    // The accelerations with only the multi force applied must match those
+    // with only the single-sphere forces applied.
+    auto calcAccelerations = [&](bool applySingles) {
+        for (auto* force : singles) force->setAppliesForce(state, applySingles);
+        multi->setAppliesForce(state, !applySingles);
+        model.realizeAcceleration(state);
+        return Vector(state.getUDot());
+    };
+    const Vector udotSingles = calcAccelerations(true);
+    const Vector udotMulti = calcAccelerations(false);
+    for (int i = 0; i < udotSingles.size(); ++i) {
+        ASSERT_EQUAL(udotSingles[i], udotMulti[i],
+                1e-8 * (1 + std::abs(udotSingles[i])), __FILE__, __LINE__,
+                "Acceleration " + std::to_string(i) + " differs.");
+    }
+    // The contact forces change the accelerations substantially.
+    multi->setAppliesForce(state, false);
+    model.realizeAcceleration(state);
+    ASSERT((state.getUDot() - udotMulti).norm() > 1.0);
+
+    // Compare the derivatives to central differences. Without rotation of
+    // the block, the translational coordinates and speeds move all spheres.
+    // The forces are recomputed whenever the state changes.
+    rx.setValue(state, 0);
+    rz.setValue(state, 0);
+    rx.setSpeedValue(state, 0);
+    model.realizeVelocity(state);
+    Vector_<Mat33> dForce_dPosition;
+    Vector_<Mat33> dForce_dVelocity;
+    multi->calcSphereForceDerivatives(
+            state, dForce_dPosition, dForce_dVelocity);
+    ASSERT(dForce_dPosition.size() == 3 && dForce_dVelocity.size() == 3);
+
+    const std::vector<const Coordinate*> translations{&tx, &ty, &tz};
+    const double h = 1e-7;
+    Vector_<Vec3> forcesPlus, forcesMinus, points;
+    for (int j = 0; j < 3; ++j) {
+        const Coordinate& coord = *translations[j];
+        const double q = coord.getValue(state);
+        coord.setValue(state, q + h);
+        model.realizeVelocity(state);
+        multi->calcSphereForces(state, forcesPlus, points);
+        coord.setValue(state, q - h);
+        model.realizeVelocity(state);
+        multi->calcSphereForces(state, forcesMinus, points);
+        coord.setValue(state, q);
+
+        const double u = coord.getSpeedValue(state);
+        Vector_<Vec3> forcesPlusU, forcesMinusU;
+        coord.setSpeedValue(state, u + h);
+        model.realizeVelocity(state);
+        multi->calcSphereForces(state, forcesPlusU, points);
+        coord.setSpeedValue(state, u - h);
+        model.realizeVelocity(state);
+        multi->calcSphereForces(state, forcesMinusU, points);
+        coord.setSpeedValue(state, u);
+
+        for (int i = 0; i < 3; ++i) {
+            const Vec3 dPosition = (forcesPlus[i] - forcesMinus[i]) / (2 * h);
+            const Vec3 dVelocity =
+                    (forcesPlusU[i] - forcesMinusU[i]) / (2 * h);
+            for (int k = 0; k < 3; ++k) {
+                ASSERT_EQUAL(dPosition[k], dForce_dPosition[i](k, j),
+                        1e-4 * (1 + std::abs(dPosition[k])));
+                ASSERT_EQUAL(dVelocity[k], dForce_dVelocity[i](k, j),
+                        1e-4 * (1 + std::abs(dVelocity[k])));
+            }
+        }
+    }
+
+    std::unique_ptr<MultiSmoothSphereHalfSpaceForce> copy(multi->clone());
+    ASSERT(*copy == *multi);
+}
+
 void testCoordinateLimitForce() {
     using namespace SimTK;
 
@@ -28,11 +28,13 @@
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/BufferedMarkersReference.h>
 #include <OpenSim/Simulation/BufferedOrientationsReference.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <random>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -82,6 +84,13 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that track() follows marker frames pushed from another thread into
+// a BufferedMarkersReference.
+void testTrackWithBufferedMarkersReference();
+// Verify that track() draws frames only from the references that stream
+// them, and that it rejects streams that disagree on time or that end before
+// the other stream.
+void testTrackWithStreamedAndStaticReferences();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
@@ -118,6 +127,16 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
+    try { testTrackWithBufferedMarkersReference(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackWithBufferedMarkersReference");
+    }
+    try { testTrackWithStreamedAndStaticReferences(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackWithStreamedAndStaticReferences");
+    }
 
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
@@ -576,6 +595,208 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testTrackWithBufferedMarkersReference()
+{
+    cout << "\ntestInverseKinematicsSolver::"
+            "testTrackWithBufferedMarkersReference()" << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    const double dt = 0.01;
+    const int numFrames = 20;
+    for (int i = 0; i < numFrames; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, 0.05*i);
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    const TimeSeriesTable_<SimTK::Vec3> markerData =
+            generateMarkerDataFromModelAndStates(*pendulum, states, biases);
+    // Only the first frame is known when the solver is created.
+    TimeSeriesTable_<SimTK::Vec3> firstFrame = markerData;
+    firstFrame.trim(0, 0);
+    auto markersRef = std::make_shared<BufferedMarkersReference>(
+            firstFrame, Set<MarkerWeight>());
+    markersRef->setDefaultWeight(1.0);
+    markersRef->setCapacity(4);
+    ASSERT(markersRef->getCapacity() == 4);
+    ASSERT(markersRef->getValidTimeRange()[1] == SimTK::Infinity);
+    ASSERT(markersRef->hasNext());
+
+    // A copy has its own, empty, buffer.
+    std::unique_ptr<BufferedMarkersReference> copy(markersRef->clone());
+    ASSERT(copy->getCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT(copy->tryPutValues(i, markerData.getRowAtIndex(i)));
+    }
+    ASSERT(!copy->tryPutValues(4, markerData.getRowAtIndex(4)));
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coord.setValue(state, 0.0);
+    state.updTime() = 0;
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(1e-6);
+    ikSolver.assemble(state);
+    ASSERT_EQUAL(0.0, coord.getValue(state), 1e-5);
+
+    // The producer waits whenever the (small) buffer is full.
+    std::thread producer([&]() {
+        for (int i = 1; i < numFrames; ++i) {
+            markersRef->putValues(i*dt, markerData.getRowAtIndex(i));
+        }
+        markersRef->setFinished(true);
+    });
+    ikSolver.setAdvanceTimeFromReference(true);
+    for (int i = 1; i < numFrames; ++i) {
+        ikSolver.track(state);
+        ASSERT_EQUAL(i*dt, state.getTime(), 1e-12);
+        ASSERT_EQUAL(0.05*i, coord.getValue(state), 1e-5);
+    }
+    producer.join();
+    ASSERT(!markersRef->hasNext());
+}
+
+void testTrackWithStreamedAndStaticReferences()
+{
+    cout << "\ntestInverseKinematicsSolver::"
+            "testTrackWithStreamedAndStaticReferences()" << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Body& ball = pendulum->updBodySet().get("ball");
+    ball.addComponent(new PhysicalOffsetFrame("ball_imu", ball,
+            SimTK::Transform(SimTK::Rotation(0.3, SimTK::XAxis))));
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    const double dt = 0.01;
+    const int numFrames = 10;
+    for (int i = 0; i < numFrames; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, 0.05*i);
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> markerBiases(3, SimTK::Vec3(0));
+    const TimeSeriesTable_<SimTK::Vec3> markerData =
+            generateMarkerDataFromModelAndStates(
+                    *pendulum, states, markerBiases);
+    SimTK::RowVector_<SimTK::Rotation> orientationBiases(
+            1, SimTK::Rotation());
+    const TimeSeriesTable_<SimTK::Rotation> orientationData =
+            generateOrientationsDataFromModelAndStates(
+                    *pendulum, states, orientationBiases, 0);
+    TimeSeriesTable_<SimTK::Vec3> firstMarkerFrame = markerData;
+    firstMarkerFrame.trim(0, 0);
+    TimeSeriesTable_<SimTK::Rotation> firstOrientationFrame = orientationData;
+    firstOrientationFrame.trim(0, 0);
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    {
+        // Static markers with streamed orientations: the orientations
+        // determine the time at which the markers are taken.
+        auto markersRef = std::make_shared<MarkersReference>(
+                markerData, Set<MarkerWeight>());
+        markersRef->setDefaultWeight(1.0);
+        auto orientationsRef = std::make_shared<BufferedOrientationsReference>(
+                firstOrientationFrame);
+        orientationsRef->set_default_weight(1.0);
+        for (int i = 1; i < numFrames; ++i) {
+            ASSERT(orientationsRef->tryPutValues(
+                    i*dt, orientationData.getRowAtIndex(i)));
+        }
+        orientationsRef->setFinished(true);
+
+        coord.setValue(state, 0.0);
+        state.updTime() = 0;
+        InverseKinematicsSolver ikSolver(
+                *pendulum, markersRef, orientationsRef, coordRefs);
+        ikSolver.setAccuracy(1e-6);
+        ikSolver.assemble(state);
+        ikSolver.setAdvanceTimeFromReference(true);
+        for (int i = 1; i < numFrames; ++i) {
+            ikSolver.track(state);
+            ASSERT_EQUAL(i*dt, state.getTime(), 1e-12);
+            ASSERT_EQUAL(0.05*i, coord.getValue(state), 1e-5);
+        }
+        // Neither reference has a next frame.
+        ASSERT(!orientationsRef->hasNext());
+        ASSERT_THROW(OpenSim::Exception, ikSolver.track(state));
+    }
+    {
+        // Both references streamed: the times of their frames must agree.
+        auto markersRef = std::make_shared<BufferedMarkersReference>(
+                firstMarkerFrame, Set<MarkerWeight>());
+        markersRef->setDefaultWeight(1.0);
+        auto orientationsRef = std::make_shared<BufferedOrientationsReference>(
+                firstOrientationFrame);
+        orientationsRef->set_default_weight(1.0);
+        ASSERT(markersRef->tryPutValues(dt, markerData.getRowAtIndex(1)));
+        ASSERT(orientationsRef->tryPutValues(
+                dt, orientationData.getRowAtIndex(1)));
+        ASSERT(markersRef->tryPutValues(2*dt, markerData.getRowAtIndex(2)));
+        ASSERT(orientationsRef->tryPutValues(
+                3*dt, orientationData.getRowAtIndex(3)));
+
+        coord.setValue(state, 0.0);
+        state.updTime() = 0;
+        InverseKinematicsSolver ikSolver(
+                *pendulum, markersRef, orientationsRef, coordRefs);
+        ikSolver.setAccuracy(1e-6);
+        ikSolver.assemble(state);
+        ikSolver.setAdvanceTimeFromReference(true);
+        ikSolver.track(state);
+        ASSERT_EQUAL(dt, state.getTime(), 1e-12);
+        ASSERT_EQUAL(0.05, coord.getValue(state), 1e-5);
+        ASSERT_THROW(OpenSim::Exception, ikSolver.track(state));
+    }
+    {
+        // The marker stream finishes before the orientation stream: once the
+        // markers are drained, track() throws instead of waiting for a
+        // marker frame that will never be pushed.
+        auto markersRef = std::make_shared<BufferedMarkersReference>(
+                firstMarkerFrame, Set<MarkerWeight>());
+        markersRef->setDefaultWeight(1.0);
+        auto orientationsRef = std::make_shared<BufferedOrientationsReference>(
+                firstOrientationFrame);
+        orientationsRef->set_default_weight(1.0);
+        const int numMarkerFrames = 3;
+        for (int i = 1; i < numFrames; ++i) {
+            if (i < numMarkerFrames) {
+                ASSERT(markersRef->tryPutValues(
+                        i*dt, markerData.getRowAtIndex(i)));
+            }
+            ASSERT(orientationsRef->tryPutValues(
+                    i*dt, orientationData.getRowAtIndex(i)));
+        }
+        markersRef->setFinished(true);
+        orientationsRef->setFinished(true);
+
+        coord.setValue(state, 0.0);
+        state.updTime() = 0;
+        InverseKinematicsSolver ikSolver(
+                *pendulum, markersRef, orientationsRef, coordRefs);
+        ikSolver.setAccuracy(1e-6);
+        ikSolver.assemble(state);
+        ikSolver.setAdvanceTimeFromReference(true);
+        for (int i = 1; i < numMarkerFrames; ++i) {
+            ikSolver.track(state);
+            ASSERT_EQUAL(i*dt, state.getTime(), 1e-12);
+            ASSERT_EQUAL(0.05*i, coord.getValue(state), 1e-5);
+        }
+        ASSERT(!markersRef->hasNext());
+        ASSERT(orientationsRef->hasNext());
+        ASSERT_THROW(OpenSim::Exception, ikSolver.track(state));
+        SimTK::Array_<SimTK::Vec3> markerValues;
+        ASSERT_THROW(OpenSim::Exception,
+                markersRef->getNextValuesAndTime(markerValues));
+    }
+}
+
 void testNumberOfMarkersMismatch()
 {
     cout << 
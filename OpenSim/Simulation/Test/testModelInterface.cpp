@@ -32,6 +32,7 @@ using namespace std;
 
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
+void testModelFork();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -39,6 +40,7 @@ int main() {
     SimTK_START_TEST("testModelInterface");
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
+        SimTK_SUBTEST(testModelFork);
     SimTK_END_TEST();
 }
 
@@ -227,3 +229,45 @@ void testModelTopologyErrors()
 
     ASSERT_THROW(JointFramesHaveSameBaseFrame, degenerate.initSystem());
 }
+
+void testModelFork()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    s.setTime(0.3);
+    model.getCoordinateSet().get("r_shoulder_elev").setValue(s, 0.4);
+    model.getCoordinateSet().get("r_elbow_flex").setSpeedValue(s, -1.2);
+    model.getCoordinateSet().get("r_shoulder_elev").setLocked(s, true);
+    const Muscle& muscle = model.getMuscles().get(0);
+    muscle.setActivation(s, 0.6);
+    model.getMuscles().get(1).setAppliesForce(s, false);
+    model.realizeAcceleration(s);
+
+    std::unique_ptr<Model> fork(model.fork(s));
+    SimTK::State& forkState = fork->updWorkingState();
+    ASSERT(forkState.getTime() == s.getTime());
+    ASSERT(forkState.getNY() == s.getNY());
+    for (int i = 0; i < s.getNY(); ++i) {
+        ASSERT(forkState.getY()[i] == s.getY()[i]);
+    }
+    ASSERT(fork->getCoordinateSet().get("r_shoulder_elev").getLocked(
+            forkState));
+    ASSERT(!fork->getMuscles().get(1).appliesForce(forkState));
+
+    // The copy computes the same quantities as the model, independently.
+    fork->realizeAcceleration(forkState);
+    ASSERT_EQUAL(muscle.getLength(s),
+            fork->getMuscles().get(0).getLength(forkState), 1e-12,
+            __FILE__, __LINE__, "Muscle lengths differ.");
+    for (int i = 0; i < s.getNU(); ++i) {
+        ASSERT_EQUAL(s.getUDot()[i], forkState.getUDot()[i], 1e-10,
+                __FILE__, __LINE__, "Accelerations differ.");
+    }
+    fork->getCoordinateSet().get("r_elbow_flex").setValue(forkState, 1.0);
+    ASSERT(model.getCoordinateSet().get("r_elbow_flex").getValue(s) !=
+           fork->getCoordinateSet().get("r_elbow_flex").getValue(forkState));
+
+    // The model must have a System.
+    Model noSystem("arm26.osim");
+    ASSERT_THROW(OpenSim::Exception, noSystem.fork(s));
+}
@@ -55,6 +55,7 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testAnalysisCache(const string& filename);
 
 int main()
 {
@@ -67,6 +68,9 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testAnalysisCache("testMomentArmsConstraintB.osim");
+        cout << "Moment arms and mass matrix shared by analyses: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -166,6 +170,59 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+// The moment arms computed together by the AnalysisCache must match those
+// computed for each path and coordinate separately.
+void testAnalysisCache(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+
+    const auto& coords = model.getCoordinateSet();
+    const auto& muscles = model.getMuscles();
+    std::vector<const Coordinate*> coordinates;
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].getLocked(s)) coordinates.push_back(&coords[i]);
+    }
+    std::vector<const GeometryPath*> paths;
+    for (int i = 0; i < muscles.getSize(); ++i) {
+        paths.push_back(&muscles[i].getGeometryPath());
+    }
+
+    AnalysisCache& cache = model.updAnalysisCache();
+    cache.requestMomentArms(paths, coordinates);
+
+    SimTK::Matrix M;
+    for (double angle : {-1.0, -0.5, 0.0, 0.3}) {
+        for (const Coordinate* coord : coordinates) {
+            if (coord->getMotionType() == Coordinate::Rotational &&
+                    !coord->isDependent(s)) {
+                coord->setValue(s, angle, false);
+            }
+        }
+        model.assemble(s);
+        model.realizePosition(s);
+
+        for (const GeometryPath* path : paths) {
+            for (const Coordinate* coord : coordinates) {
+                ASSERT_EQUAL(path->computeMomentArm(s, *coord),
+                        cache.getMomentArm(s, *path, *coord), 1e-10,
+                        __FILE__, __LINE__,
+                        "Moment arm of " + path->getOwner().getName() +
+                        " about " + coord->getName() + " differs.");
+            }
+        }
+
+        model.getMatterSubsystem().calcM(s, M);
+        const SimTK::Matrix& cachedM = cache.getMassMatrix(s);
+        ASSERT(cachedM.nrow() == M.nrow() && cachedM.ncol() == M.ncol());
+        for (int i = 0; i < M.nrow(); ++i) {
+            for (int j = 0; j < M.ncol(); ++j) {
+                ASSERT_EQUAL<double>(M(i, j), cachedM(i, j), 1e-14);
+            }
+        }
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
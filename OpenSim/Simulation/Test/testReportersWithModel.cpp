@@ -116,9 +116,70 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testAsynchronousReporting() {
+    // Create a model consisting of a falling ball.
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    auto* reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->set_report_time_interval(0.01);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    reporter->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(reporter);
+
+    // Simulate in two parts to exercise the flush at the end of integrate().
+    auto simulate = [&](bool async) {
+        reporter->set_report_asynchronously(async);
+        reporter->clearTable();
+        State state = model.initSystem();
+        Manager manager(model);
+        manager.setRecordStatesAsynchronously(async);
+        SimTK_TEST(manager.getRecordStatesAsynchronously() == async);
+        state.setTime(0.0);
+        manager.initialize(state);
+        manager.integrate(0.5);
+        SimTK_TEST(manager.getStateStorage().getSize() > 0);
+        manager.integrate(1.0);
+        return manager.getStatesTable();
+    };
+
+    const TimeSeriesTable syncStates = simulate(false);
+    const TimeSeriesTable syncTable = reporter->getTable();
+    SimTK_TEST(syncTable.getNumRows() > 50);
+
+    const TimeSeriesTable asyncStates = simulate(true);
+    const TimeSeriesTable& asyncTable = reporter->getTable();
+
+    SimTK_TEST(asyncStates.getNumRows() == syncStates.getNumRows());
+    SimTK_TEST(asyncStates.getColumnLabels() == syncStates.getColumnLabels());
+    SimTK_TEST_EQ(asyncStates.getMatrix(), syncStates.getMatrix());
+    SimTK_TEST(asyncTable.getColumnLabels() == syncTable.getColumnLabels());
+    SimTK_TEST(asyncTable.getIndependentColumn() ==
+               syncTable.getIndependentColumn());
+    SimTK_TEST_EQ(asyncTable.getMatrix(), syncTable.getMatrix());
+
+    // Reporting the same times again without clearing the table is an error,
+    // as it is when reporting synchronously.
+    {
+        State state = model.initSystem();
+        Manager manager(model);
+        manager.initialize(state);
+        SimTK_TEST_MUST_THROW_EXC(manager.integrate(1.0), OpenSim::Exception);
+    }
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testAsynchronousReporting);
     SimTK_END_TEST();
 };
@@ -25,18 +25,22 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/EnsembleSimulator.h>
+#include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
 using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testEnsembleSimulator();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testEnsembleSimulator);
     SimTK_END_TEST();
 }
 
@@ -193,3 +197,96 @@ void testUpdatePre40KinematicsFor40MotionType() {
 
 
 
+
+void testEnsembleSimulator() {
+    using SimTK::Vec3;
+    const double gravity = 9.81;
+
+    // A ball launched upward with a random initial speed.
+    Model model;
+    model.setGravity(Vec3(0, -gravity, 0));
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    auto reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->set_report_time_interval(0.1);
+    reporter->addToReport(
+            freeJoint->getCoordinate(FreeJoint::Coord::TranslationY)
+                    .getOutput("value"));
+    model.addComponent(reporter);
+    SimTK::State& initialState = model.initSystem();
+
+    const int numMembers = 20;
+    const double finalTime = 1.0;
+    std::vector<double> speeds(numMembers);
+    std::vector<double> heights(numMembers);
+
+    EnsembleSimulator ensemble;
+    ensemble.setSeed(7);
+    ensemble.setIntegratorAccuracy(1e-8);
+    ensemble.setTableReporterPath("/reporter");
+    ensemble.setMemberFunction([&](int index, std::mt19937_64& rng,
+            Model& model, SimTK::State& state) {
+        std::uniform_real_distribution<double> dist(0.0, 10.0);
+        speeds[index] = dist(rng);
+        const auto& joint = model.getComponent<FreeJoint>("/jointset/freeJoint");
+        joint.getCoordinate(FreeJoint::Coord::TranslationY)
+                .setSpeedValue(state, speeds[index]);
+    });
+    ensemble.setResultFunction([&](int index, const Model& model,
+            const SimTK::State& finalState) {
+        const auto& joint = model.getComponent<FreeJoint>("/jointset/freeJoint");
+        heights[index] = joint.getCoordinate(FreeJoint::Coord::TranslationY)
+                .getValue(finalState);
+    });
+
+    auto runEnsemble = [&](int numThreads) {
+        ensemble.setNumThreads(numThreads);
+        return ensemble.simulate(model, initialState, finalTime, numMembers);
+    };
+
+    const auto serialStates = runEnsemble(1);
+    const auto serialSpeeds = speeds;
+    SimTK_TEST((int)serialStates.size() == numMembers);
+    SimTK_TEST((int)ensemble.getTables().size() == numMembers);
+    for (int i = 0; i < numMembers; ++i) {
+        SimTK_TEST_EQ(serialStates[i].getTime(), finalTime);
+        const double expected =
+                speeds[i] * finalTime - 0.5 * gravity * finalTime * finalTime;
+        SimTK_TEST_EQ_TOL(heights[i], expected, 1e-6);
+        const auto& table = ensemble.getTables()[i];
+        // The table is cleared between members.
+        SimTK_TEST(table.getNumRows() >= 10 && table.getNumRows() <= 11);
+        const int last = (int)table.getNumRows() - 1;
+        SimTK_TEST_EQ_TOL(table.getIndependentColumn()[last], finalTime, 1e-8);
+        SimTK_TEST_EQ_TOL(table.getMatrix()(last, 0), expected, 1e-6);
+    }
+    // The members differ from each other.
+    SimTK_TEST(speeds[0] != speeds[1]);
+
+    // The results do not depend on the number of threads.
+    const auto parallelStates = runEnsemble(3);
+    for (int i = 0; i < numMembers; ++i) {
+        SimTK_TEST_EQ(speeds[i], serialSpeeds[i]);
+        SimTK_TEST_EQ(parallelStates[i].getY(), serialStates[i].getY());
+    }
+
+    // A different seed gives different samples.
+    ensemble.setSeed(8);
+    runEnsemble(2);
+    SimTK_TEST(speeds[0] != serialSpeeds[0]);
+    SimTK_TEST(EnsembleSimulator::calcMemberSeed(8, 0) !=
+               EnsembleSimulator::calcMemberSeed(8, 1));
+
+    // Exceptions thrown by the member function are rethrown.
+    ensemble.setMemberFunction([](int index, std::mt19937_64&, Model&,
+            SimTK::State&) {
+        if (index == 5) OPENSIM_THROW(Exception, "Member 5 failed.");
+    });
+    SimTK_TEST_MUST_THROW_EXC(runEnsemble(2), Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            ensemble.simulate(model, initialState, 0.0, numMembers),
+            Exception);
+}
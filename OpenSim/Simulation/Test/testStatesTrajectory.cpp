@@ -546,6 +546,106 @@ void testCopying() {
     }
 }
 
+void testCompact() {
+    Model model("gait2354_simbody.osim");
+    auto& state = model.initSystem();
+    const auto& coord = model.getCoordinateSet().get("hip_flexion_r");
+
+    // Full and compact trajectories containing the same states.
+    StatesTrajectory full;
+    StatesTrajectory compact;
+    compact.setCompact(true);
+    SimTK_TEST(!full.isCompact());
+    SimTK_TEST(compact.isCompact());
+    for (int i = 0; i < 5; ++i) {
+        state.setTime(0.1 * i);
+        coord.setValue(state, 0.05 * i, false);
+        full.append(state);
+        compact.append(state);
+    }
+
+    // Can only change compactness when empty.
+    SimTK_TEST_MUST_THROW_EXC(compact.setCompact(false), Exception);
+
+    SimTK_TEST(compact.hasIntegrity());
+    SimTK_TEST(compact.isCompatibleWith(model));
+    SimTK_TEST_EQ((int)compact.getSize(), (int)full.getSize());
+    int itime = 0;
+    for (const auto& s : compact) {
+        SimTK_TEST_EQ(s.getTime(), full[itime].getTime());
+        SimTK_TEST_EQ(s.getY(), full[itime].getY());
+        SimTK_TEST_EQ(coord.getValue(s), 0.05 * itime);
+        ++itime;
+    }
+    // Accessing the same index twice gives the same state.
+    SimTK_TEST(&compact.back() == &compact[4]);
+    SimTK_TEST_MUST_THROW_EXC(compact.get(5), IndexOutOfRange);
+
+    // Visit the states with a single working state.
+    SimTK::State working = compact.front();
+    for (size_t i = 0; i < compact.getSize(); ++i) {
+        compact.copyTimeAndY(i, working);
+        SimTK_TEST_EQ(working.getTime(), full[i].getTime());
+        SimTK_TEST_EQ(working.getY(), full[i].getY());
+        model.realizeAcceleration(working);
+    }
+
+    // Copies are also compact.
+    StatesTrajectory compactCopy(compact);
+    SimTK_TEST(compactCopy.isCompact());
+    SimTK_TEST_EQ((int)compactCopy.getSize(), (int)compact.getSize());
+    SimTK_TEST_EQ(compactCopy[3].getY(), compact[3].getY());
+
+    // The exported tables are the same.
+    const auto fullTable = full.exportToTable(model);
+    const auto compactTable = compact.exportToTable(model);
+    SimTK_TEST_EQ(compactTable.getMatrix(), fullTable.getMatrix());
+
+    // clear() keeps the trajectory compact.
+    compact.clear();
+    SimTK_TEST(compact.isCompact());
+    SimTK_TEST(compact.getSize() == 0);
+
+    // Trajectories created from a table are compact only if requested.
+    auto fromTable = StatesTrajectory::createFromStatesTable(model, fullTable);
+    SimTK_TEST(!fromTable.isCompact());
+    auto compactFromTable = StatesTrajectory::createFromStatesTable(model,
+            fullTable, false, false, false, true);
+    SimTK_TEST(compactFromTable.isCompact());
+    SimTK_TEST_EQ(compactFromTable.exportToTable(model).getMatrix(),
+            fullTable.getMatrix());
+
+    // A compact trajectory keeps only a bounded number of states, and
+    // recreates the others when they are accessed again.
+    const int numStates = 2 * (int)StatesTrajectory::MaxCachedStates + 1;
+    for (int i = 0; i < numStates; ++i) {
+        state.setTime(0.01 * i);
+        coord.setValue(state, 0.01 * i, false);
+        compact.append(state);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < numStates; ++i) {
+            SimTK_TEST_EQ(compact[i].getTime(), 0.01 * i);
+            SimTK_TEST_EQ(coord.getValue(compact[i]), 0.01 * i);
+        }
+    }
+    compact.clear();
+    compact.setCompact(false);
+    SimTK_TEST(!compact.isCompact());
+
+    // StatesTrajectoryReporter with compact storage.
+    auto* reporter = new StatesTrajectoryReporter();
+    reporter->set_compact(true);
+    model.addComponent(reporter);
+    auto& reporterState = model.initSystem();
+    Manager manager(model);
+    manager.initialize(reporterState);
+    manager.integrate(0.02);
+    SimTK_TEST(reporter->getStates().isCompact());
+    SimTK_TEST(reporter->getStates().getSize() > 1);
+    SimTK_TEST(reporter->getStates().hasIntegrity());
+}
+
 void testAppendTimesAreNonDecreasing() {
     Model model("gait2354_simbody.osim");
     auto& state = model.initSystem();
@@ -787,6 +887,7 @@ int main() {
         SimTK_SUBTEST(testIntegrityChecks);
         SimTK_SUBTEST(testAppendTimesAreNonDecreasing);
         SimTK_SUBTEST(testCopying);
+        SimTK_SUBTEST(testCompact);
 
         // Test creation of trajectory from a states storage.
         // -------------------------------------------------
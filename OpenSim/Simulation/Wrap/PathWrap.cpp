@@ -83,6 +83,9 @@ void PathWrap::extendConnectToModel(Model& model)
 {
     Super::extendConnectToModel(model);
 
+    // The wrap object or the method may have changed.
+    resetPreviousWrap();
+
     _path = dynamic_cast<const GeometryPath*>(&getOwner());
     std::string msg = "PathWrap '" + getName()
         + "' must have a GeometryPath as its owner.";
@@ -149,6 +152,8 @@ void PathWrap::resetPreviousWrap()
         _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
         _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
         _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        _previousWrap.p1[i] = SimTK::NaN;
+        _previousWrap.p2[i] = SimTK::NaN;
     }
 }
 
@@ -175,4 +180,5 @@ void PathWrap::setMethod(WrapMethod aMethod)
         _method = hybrid;
         upd_method() = "hybrid";
     }
+    resetPreviousWrap();
 }
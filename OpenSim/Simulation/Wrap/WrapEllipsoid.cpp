@@ -48,6 +48,7 @@ static const char* wrapTypeName = "ellipsoid";
 #define NUM_DISPLAY_SAMPLES   30
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
+#define COHERENCE_TOLERANCE   1e-5     // max (normalized) motion of the path points to reuse the previous wrapping plane
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -83,6 +84,7 @@ void WrapEllipsoid::constructProperties()
 
     SimTK::Vec3 defaultDimensions = {0.05, 0.05, 0.05};
     constructProperty_dimensions(defaultDimensions);
+    constructProperty_reuse_wrapping_plane(false);
 }
 
 //_____________________________________________________________________________
@@ -190,11 +192,10 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
                                      const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const
 {
     int i, j, bestMu;
-    SimTK::Vec3 p1, p2, m, a, p1p2, p1m, p2m, f1, f2, p1c1, r1r2, vs, t, mu;
+    SimTK::Vec3 p1, p2, m, a, p1p2, p1m, p2m, f1, f2, r1r2, t, mu;
     double ppm, aa, bb, cc, disc, l1, l2,
-        p1e, p2e, vs4, dist, fanWeight = -SimTK::Infinity;
+        p1e, p2e, dist, fanWeight = -SimTK::Infinity;
     double t_sv[3][3], t_c1[3][3];
-    bool far_side_wrap = false;
    static SimTK::Vec3 origin(0,0,0);
 
     // In case you need any variables from the previous wrap, copy them from
@@ -326,6 +327,33 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
         return noWrap;
     }
 
+    // If enabled (see reuse_wrapping_plane), and the path points have barely
+    // moved since the last full computation of the wrap over this object
+    // (e.g., between the iterations over multiple wrap objects in
+    // GeometryPath, or between integration steps), the wrapping plane is
+    // still valid: skip the (expensive) computation of the plane and refine
+    // the previous tangent points. The previous tangent points were
+    // transformed to the frame of the wrap object's body and unnormalized.
+    // The path points of the last full computation are kept (rather than
+    // replaced by the current ones) so that a series of small motions cannot
+    // drift away from the plane without a full computation.
+    if (get_reuse_wrapping_plane() &&
+        (p1 - previousWrap.p1).norm() < COHERENCE_TOLERANCE &&
+        (p2 - previousWrap.p2).norm() < COHERENCE_TOLERANCE)
+    {
+        aWrapResult.p1 = previousWrap.p1;
+        aWrapResult.p2 = previousWrap.p2;
+        aWrapResult.r1 = _pose.shiftBaseStationToFrame(previousWrap.r1) * aWrapResult.factor;
+        aWrapResult.r2 = _pose.shiftBaseStationToFrame(previousWrap.r2) * aWrapResult.factor;
+        aWrapResult.c1 = previousWrap.c1;
+        aWrapResult.sv = previousWrap.sv;
+
+        return calcWrapPath(p1, p2, m, a, p1e, p2e, aWrapResult);
+    }
+
+    aWrapResult.p1 = p1;
+    aWrapResult.p2 = p2;
+
     // r1 & r2: intersection points of p1->p2 with the ellipsoid
     for (i = 0; i < 3; i++)
     {
@@ -532,7 +560,37 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
         }
     }
 
+    return calcWrapPath(p1, p2, m, a, p1e, p2e, aWrapResult);
+}
+
+//_____________________________________________________________________________
+/**
+ * Calculate the tangent points and the wrap path over the ellipsoid in the
+ * plane through p1, p2, and the point c1 of the wrap result, starting the
+ * search for the tangent points from r1 and r2 of the wrap result. All
+ * quantities are normalized; the output coordinates of the wrap result are
+ * unnormalized.
+ *
+ * @param p1 One end of the line segment
+ * @param p2 The other end of the line segment
+ * @param m Ellipsoid origin
+ * @param a Ellipsoid axis
+ * @param p1e Ellipsoid parameter for 'p1'
+ * @param p2e Ellipsoid parameter for 'p2'
+ * @param aWrapResult The result of the wrapping (tangent points, etc.)
+ * @return The status, as a WrapAction enum
+ */
+int WrapEllipsoid::calcWrapPath(SimTK::Vec3& p1, SimTK::Vec3& p2,
+        SimTK::Vec3& m, SimTK::Vec3& a, double p1e, double p2e,
+        WrapResult& aWrapResult) const
+{
+    int i;
+    SimTK::Vec3 p1p2, p1c1, vs;
+    double vs4;
+    bool far_side_wrap = false;
+
     // use p1, p2, and c1 to create parameters for the wrapping plane
+    p1p2 = p1 - p2;
     p1c1 = p1 - aWrapResult.c1;
     vs = p1p2 % p1c1;
     WrapMath::NormalizeOrZero(vs, vs);
@@ -48,6 +48,13 @@ public:
 //=============================================================================
     OpenSim_DECLARE_PROPERTY(dimensions, SimTK::Vec3,
                              "The length of the radii of the ellipsoid.");
+    OpenSim_DECLARE_PROPERTY(reuse_wrapping_plane, bool,
+        "Reuse the wrapping plane of the previous wrap, and refine its "
+        "tangent points, while the path points stay within a small tolerance "
+        "of those of the last full computation (default: false). This is "
+        "faster for paths that wrap over several ellipsoids, but the result "
+        "then depends on the previous wraps (within about 1e-7), not only on "
+        "the state.");
 
 //=============================================================================
 // METHODS
@@ -77,6 +84,9 @@ protected:
 private:
     void constructProperties();
 
+    int calcWrapPath(SimTK::Vec3& p1, SimTK::Vec3& p2, SimTK::Vec3& m,
+            SimTK::Vec3& a, double p1e, double p2e,
+            WrapResult& aWrapResult) const;
     int calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const;
     void CalcDistanceOnEllipsoid(SimTK::Vec3& r1, SimTK::Vec3& r2, SimTK::Vec3& m, SimTK::Vec3& a, 
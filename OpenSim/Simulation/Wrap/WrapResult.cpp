@@ -55,6 +55,8 @@ void WrapResult::copyData(const WrapResult& aWrapResult) {
         r2[i] = aWrapResult.r2[i];
         c1[i] = aWrapResult.c1[i];
         sv[i] = aWrapResult.sv[i];
+        p1[i] = aWrapResult.p1[i];
+        p2[i] = aWrapResult.p2[i];
     }
 
     singleWrap = aWrapResult.singleWrap;
@@ -56,6 +56,12 @@ public:
     SimTK::Vec3 r2;              // wrap tangent point nearest to p2
     SimTK::Vec3 c1;              // intermediate point used by some wrap objects
     SimTK::Vec3 sv;              // intermediate point used by some wrap objects
+    // The path points, in the normalized frame of the wrap object, of the
+    // last full computation of the wrap that this result derives from. Used
+    // by some wrap objects to reuse the previous result while the path
+    // points stay close to these points.
+    SimTK::Vec3 p1{SimTK::NaN};
+    SimTK::Vec3 p2{SimTK::NaN};
     // TODO(chrisdembia): This member variable is not copied by the copy
     // constructor or copy assignment operator, so I've initialized it to NaN
     // so we can more easily detect any bugs caused by not copying this
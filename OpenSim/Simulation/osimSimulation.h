@@ -37,11 +37,14 @@
 #include "Model/ContactGeometrySet.h"
 #include "Model/ContactHalfSpace.h"
 #include "Model/ContactMesh.h"
+#include "Model/MeshCache.h"
 #include "Model/ContactSphere.h"
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
+#include "Model/MeshElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/MultiSmoothSphereHalfSpaceForce.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -129,6 +132,8 @@
 #include "OpenSense/OpenSenseUtilities.h"
 #include "OpenSense/IMU.h"
 #include "SimulationUtilities.h"
+#include "EnsembleSimulator.h"
+#include "StreamingInverseKinematics.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
@@ -34,6 +34,8 @@ using namespace std;
 
 void testSingleWrapObjectPerpendicular(OpenSim::WrapObject* wObj, Vec3 axialRotation = Vec3(0.0));
 void testEllipsoidWrapLength(OpenSim::WrapEllipsoid* wObj);
+void testEllipsoidWrapCoherence();
+void testEllipsoidWrapCoherenceDrift();
 
 const double radius = 0.5;
 int main()
@@ -112,6 +114,22 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("testEllipsoidWrapLength");
     }
+
+    try {
+        testEllipsoidWrapCoherence();
+    }
+    catch (const std::exception& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        failures.push_back("testEllipsoidWrapCoherence");
+    }
+
+    try {
+        testEllipsoidWrapCoherenceDrift();
+    }
+    catch (const std::exception& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        failures.push_back("testEllipsoidWrapCoherenceDrift");
+    }
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << std::endl;
         return 1;
@@ -240,3 +258,108 @@ void testEllipsoidWrapLength(OpenSim::WrapEllipsoid* wrapObject)
 
 }
 
+// A model with identical springs, named springNames, that wrap over an
+// ellipsoid attached to ground while their insertion rotates about a pin
+// joint. The ellipsoid is tilted so that the wrapping plane is not a plane of
+// symmetry of the ellipsoid.
+std::unique_ptr<Model> createEllipsoidWrapModel(
+        const std::vector<std::string>& springNames, bool reuseWrappingPlane)
+{
+    const double r = radius;
+    std::unique_ptr<Model> model(new Model());
+
+    auto& ground = model->updGround();
+    auto body = new OpenSim::Body("body", 1, Vec3(-r, 0, 0), Inertia(0.1, 0.1, 0.01));
+    model->addComponent(body);
+
+    auto joint = new PinJoint("pin", ground, *body);
+    auto& qi = joint->updCoordinate();
+    qi.setName("q_pin");
+    model->addComponent(joint);
+
+    auto* wObj = new WrapEllipsoid();
+    wObj->setName("ellipsoid");
+    wObj->set_dimensions(Vec3(1.5 * r, r, 0.8 * r));
+    wObj->set_xyz_body_rotation(Vec3(0.3, 0.2, 0));
+    wObj->set_reuse_wrapping_plane(reuseWrappingPlane);
+    ground.addWrapObject(wObj);
+
+    for (const auto& name : springNames) {
+        PathSpring* spring = new PathSpring(name, 1.0, 0.1, 0.01);
+        spring->updGeometryPath().
+            appendNewPathPoint("origin", ground, Vec3(r - .1, r, 0.05));
+        spring->updGeometryPath().
+            appendNewPathPoint("insert", *body, Vec3(-1.5 * r, -r, -0.05));
+        spring->updGeometryPath().addPathWrap(*wObj);
+        model->addComponent(spring);
+    }
+
+    model->finalizeConnections();
+    return model;
+}
+
+// When the path points move only slightly between two wraps over an
+// ellipsoid that reuses the wrapping plane, the wrap refines the previous
+// tangent points. Compare the resulting lengths to those of the full wrap
+// computation (without a previous wrap), for small and large increments of
+// the coordinate. By default, the plane is not reused and the lengths are
+// identical.
+void testEllipsoidWrapCoherence()
+{
+    for (bool reuseWrappingPlane : {false, true}) {
+        auto model = createEllipsoidWrapModel({"spring"}, reuseWrappingPlane);
+        SimTK::State& s = model->initSystem();
+        const Coordinate& coord = model->getCoordinateSet().get("q_pin");
+        auto& spring = model->updComponent<PathSpring>("spring");
+        PathWrap& pathWrap = spring.updGeometryPath().updWrapSet().get(0);
+
+        for (double increment : {1e-7, 1e-3}) {
+            double q = 0.2;
+            for (int i = 0; i < 20; ++i) {
+                q += increment;
+                coord.setValue(s, q);
+                const double lengthFromPrevious = spring.getLength(s);
+
+                pathWrap.resetPreviousWrap();
+                coord.setValue(s, q);
+                const double lengthFull = spring.getLength(s);
+
+                if (reuseWrappingPlane) {
+                    ASSERT_EQUAL<double>(lengthFull, lengthFromPrevious, 1e-7);
+                } else {
+                    ASSERT(lengthFull == lengthFromPrevious, __FILE__,
+                            __LINE__, "Wrap depends on the previous wrap.");
+                }
+            }
+        }
+    }
+}
+
+// A long series of motions, each too small to trigger a full computation of
+// the wrap, must not let the reused wrapping plane drift: the wrap is fully
+// recomputed once the path points have moved far enough from those of the
+// last full computation. Two identical springs wrap over the same ellipsoid;
+// the first keeps its previous wrap across all steps, while the previous
+// wrap of the second is reset before every evaluation.
+void testEllipsoidWrapCoherenceDrift()
+{
+    auto model = createEllipsoidWrapModel({"chained", "full"}, true);
+    SimTK::State& s = model->initSystem();
+    const Coordinate& coord = model->getCoordinateSet().get("q_pin");
+    const auto& chained = model->getComponent<PathSpring>("chained");
+    auto& full = model->updComponent<PathSpring>("full");
+    PathWrap& fullWrap = full.updGeometryPath().updWrapSet().get(0);
+
+    // The path points move by about 1e-7 per step, far below the tolerance
+    // for reusing the plane, and by about 1e-3 in total.
+    double q = 0.2;
+    for (int i = 0; i < 10000; ++i) {
+        q += 1e-7;
+        fullWrap.resetPreviousWrap();
+        coord.setValue(s, q);
+        const double lengthChained = chained.getLength(s);
+        const double lengthFull = full.getLength(s);
+
+        ASSERT_EQUAL<double>(lengthFull, lengthChained, 1e-7);
+    }
+}
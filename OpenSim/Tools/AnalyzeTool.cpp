@@ -21,6 +21,7 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
@@ -35,6 +36,8 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -59,6 +62,7 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +83,7 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +116,7 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +177,7 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +198,7 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
 
     _statesStore = NULL;
 
@@ -236,6 +244,14 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to record the analyses. Each thread records a "
+                 "contiguous block of the time range with its own copy of the model. "
+                 "Analyses that do not support this, or that have a step_interval other "
+                 "than 1, are recorded serially. The default value is 1. A value less "
+                 "than 1 means to use the number of hardware threads.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
 }
 
 
@@ -259,6 +275,7 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -589,8 +606,15 @@ bool AnalyzeTool::run(bool plotting)
     //  _statesStore->getTime(++iInitial,ti);
     //}
 
+    const int numThreads =
+            getNumThreadsToUse(_numThreads, iFinal - iInitial + 1);
+
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    if(numThreads > 1) {
+        runInParallel(s, iInitial, iFinal, numThreads);
+    } else {
+        run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    }
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -707,3 +731,114 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         }
     }
 }
+
+//_____________________________________________________________________________
+/**
+ * Record the analyses of the model from state iInitial to state iFinal of the
+ * states storage using numThreads threads. Each thread records a contiguous
+ * block of states with its own copy of the model (the first thread uses the
+ * model itself), and the rows of the copies' storages are then appended, in
+ * time order, to the storages of the model's analyses. Analyses that cannot
+ * be recorded this way are then recorded serially with the model.
+ */
+void AnalyzeTool::runInParallel(SimTK::State& s, int iInitial, int iFinal,
+        int numThreads)
+{
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    const int na = analysisSet.getSize();
+    std::vector<bool> wasOn(na), inParallel(na);
+    bool anyInParallel = false;
+    bool anySerial = false;
+    for(int i=0; i<na; ++i) {
+        const Analysis& analysis = analysisSet.get(i);
+        wasOn[i] = analysis.getOn();
+        inParallel[i] = wasOn[i] && analysis.getCanRecordInParallel() &&
+                analysis.getStepInterval() == 1;
+        if(inParallel[i]) anyInParallel = true;
+        else if(wasOn[i]) anySerial = true;
+    }
+    if(!anyInParallel) {
+        run(s, *_model, iInitial, iFinal, *_statesStore,
+                _solveForEquilibriumForAuxiliaryStates);
+        return;
+    }
+
+    // Creating the copies is done serially; the copies also get their own
+    // copy of the states storage, whose lookups are not thread-safe.
+    struct Worker {
+        std::unique_ptr<Model> model;
+        SimTK::State state;
+        std::unique_ptr<Storage> statesStore;
+    };
+    std::vector<Worker> workers(numThreads);
+    for(int ithread=1; ithread<numThreads; ++ithread) {
+        Worker& worker = workers[ithread];
+        worker.model.reset(_model->fork(s));
+        AnalysisSet& workerAnalyses = worker.model->updAnalysisSet();
+        for(int i=0; i<na; ++i) workerAnalyses.get(i).setOn(inParallel[i]);
+        worker.state = worker.model->getWorkingState();
+        worker.model->getMultibodySystem().realize(worker.state,
+                SimTK::Stage::Position);
+        worker.statesStore.reset(new Storage(*_statesStore));
+    }
+
+    auto setAnalysesOn = [&](bool parallel, bool serial) {
+        for(int i=0; i<na; ++i) {
+            analysisSet.get(i).setOn(
+                    wasOn[i] && (inParallel[i] ? parallel : serial));
+        }
+    };
+
+    try {
+        setAnalysesOn(true, false);
+        const int numStates = iFinal - iInitial + 1;
+        parallelFor(numThreads, numThreads, [&](int ithread) {
+            const int begin = iInitial +
+                    (int)((long long)numStates * ithread / numThreads);
+            const int end = iInitial +
+                    (int)((long long)numStates * (ithread + 1) / numThreads);
+            if(ithread == 0) {
+                run(s, *_model, begin, end - 1, *_statesStore,
+                        _solveForEquilibriumForAuxiliaryStates);
+            } else {
+                Worker& worker = workers[ithread];
+                run(worker.state, *worker.model, begin, end - 1,
+                        *worker.statesStore,
+                        _solveForEquilibriumForAuxiliaryStates);
+            }
+        });
+
+        // MERGE RESULTS
+        for(int i=0; i<na; ++i) {
+            if(!inParallel[i]) continue;
+            Analysis& analysis = analysisSet.get(i);
+            ArrayPtrs<Storage>& storages = analysis.getStorageList();
+            for(int ithread=1; ithread<numThreads; ++ithread) {
+                ArrayPtrs<Storage>& workerStorages = workers[ithread].model->
+                        updAnalysisSet().get(i).getStorageList();
+                OPENSIM_THROW_IF(workerStorages.getSize() != storages.getSize(),
+                        Exception,
+                        "Expected the copies of analysis '{}' to have {} "
+                        "storages, but one has {}.",
+                        analysis.getName(), storages.getSize(),
+                        workerStorages.getSize());
+                for(int j=0; j<storages.getSize(); ++j) {
+                    const Storage& workerStorage = *workerStorages[j];
+                    for(int k=0; k<workerStorage.getSize(); ++k) {
+                        storages[j]->append(*workerStorage.getStateVector(k));
+                    }
+                }
+            }
+        }
+
+        if(anySerial) {
+            setAnalysesOn(false, true);
+            run(s, *_model, iInitial, iFinal, *_statesStore,
+                    _solveForEquilibriumForAuxiliaryStates);
+        }
+    } catch (...) {
+        setAnalysesOn(true, true);
+        throw;
+    }
+    setAnalysesOn(true, true);
+}
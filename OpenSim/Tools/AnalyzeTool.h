@@ -68,6 +68,10 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads used to record the analyses that support recording
+    in parallel. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +123,16 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    /** Number of threads used to record the analyses. The time range is split
+    into contiguous blocks, and each thread records a block with its own copy
+    of the model and its analyses; the results are then appended in time
+    order. Only analyses that support it (see
+    Analysis::getCanRecordInParallel()) and that record every step are
+    recorded in parallel; the other analyses are recorded serially afterwards.
+    The default is 1; a value less than 1 means to use the number of hardware
+    threads. */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -141,6 +155,8 @@ public:
     //--------------------------------------------------------------------------
 #ifndef SWIG
     static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+private:
+    void runInParallel(SimTK::State& s, int iInitial, int iFinal, int numThreads);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
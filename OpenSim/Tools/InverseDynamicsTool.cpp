@@ -26,6 +26,7 @@
 //=============================================================================
 #include "InverseDynamicsTool.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -36,6 +37,8 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
@@ -63,7 +66,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -82,7 +86,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -104,7 +109,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -156,6 +162,14 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _numThreadsProp.setComment("Number of threads used to solve for the "
+        "forces at the time frames, each with its own copy of the model. A "
+        "value less than 1 means to use the number of hardware threads. The "
+        "default value is 1.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
 }
 
 //_____________________________________________________________________________
@@ -187,6 +201,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _numThreads = aTool._numThreads;
     _coordinateValues = NULL;
 
     return(*this);
@@ -404,11 +419,6 @@ bool InverseDynamicsTool::run()
         int start_index = _coordinateValues->findIndex(start_time);
         int final_index = _coordinateValues->findIndex(final_time);
 
-        // create the solver given the input data
-        InverseDynamicsSolver ivdSolver(*_model);
-
-        Stopwatch watch;
-
         int nt = final_index-start_index+1;
         
         Array_<double> times(nt, 0.0);
@@ -416,21 +426,93 @@ bool InverseDynamicsTool::run()
             times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
         }
 
+        JointSet jointsForEquivalentBodyForces;
+        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
+        int nj = jointsForEquivalentBodyForces.getSize();
+
         // Preallocate results
         Array_<Vector> genForceTraj(nt, Vector(nCoords, 0.0));
+        Array_<Vector> bodyForcesTraj(nt, Vector(6*nj, 0.0));
+
+        // Solve for the generalized forces at frame i, and for the equivalent
+        // body forces at the requested joints.
+        auto solveFrame = [&](InverseDynamicsSolver& solver, SimTK::State& state,
+                const JointSet& joints, int i) {
+            genForceTraj[i] = solver.solve(state, coordFunctions,
+                    coordinatesToSpeedsIndexMap, times[i]);
+            // The solver has set the state's time, q's and u's.
+            Vector& bodyForces = bodyForcesTraj[i];
+            for(int j=0; j<nj; ++j){
+                SpatialVec equivalentBodyForceAtJoint =
+                        joints[j].calcEquivalentSpatialForce(state, genForceTraj[i]);
+                for(int k=0; k<3; ++k){
+                    // body force components
+                    bodyForces[6*j+k] = equivalentBodyForceAtJoint[1][k];
+                    // body torque components
+                    bodyForces[6*j+k+3] = equivalentBodyForceAtJoint[0][k];
+                }
+            }
+        };
+
+        int numThreads = getNumThreadsToUse(_numThreads, nt);
+        if (numThreads > 1 && _model->getAnalysisSet().getSize() > 0) {
+            log_warn("InverseDynamicsTool: the model has analyses, which must "
+                     "be stepped through the time frames in order. Solving on "
+                     "a single thread.");
+            numThreads = 1;
+        }
+
+        Stopwatch watch;
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        if (numThreads == 1) {
+            // create the solver given the input data
+            InverseDynamicsSolver ivdSolver(*_model);
+            AnalysisSet& analysisSet = _model->updAnalysisSet();
+            for(int i=0; i<nt; i++){
+                solveFrame(ivdSolver, s, jointsForEquivalentBodyForces, i);
+                analysisSet.step(s, i);
+            }
+        } else {
+            // Evaluate each coordinate function once so that the functions
+            // are ready to be evaluated concurrently.
+            for (int i = 0; i < coordFunctions.getSize(); ++i) {
+                for (int order = 0; order <= 2; ++order) {
+                    coordFunctions.evaluate(i, order, times[0]);
+                }
+            }
+
+            // Each thread solves a contiguous block of frames with its own
+            // copy of the model.
+            struct Worker {
+                std::unique_ptr<Model> model;
+                SimTK::State state;
+                JointSet joints;
+            };
+            std::vector<Worker> workers(numThreads);
+            for (auto& worker : workers) {
+                // The copies' states have the excluded forces disabled, like
+                // the state of the model.
+                worker.model.reset(_model->fork(s));
+                worker.state = worker.model->getWorkingState();
+                getJointsByName(*worker.model, _jointsForReportingBodyForces,
+                        worker.joints);
+            }
+            parallelFor(numThreads, numThreads, [&](int ithread) {
+                Worker& worker = workers[ithread];
+                InverseDynamicsSolver solver(*worker.model);
+                const int begin = (int)((long long)nt * ithread / numThreads);
+                const int end = (int)((long long)nt * (ithread + 1) / numThreads);
+                for (int i = begin; i < end; ++i) {
+                    solveFrame(solver, worker.state, worker.joints, i);
+                }
+            });
+        }
         success = true;
 
         log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
             watch.getElapsedTimeFormatted());
-    
-        JointSet jointsForEquivalentBodyForces;
-        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
-        int nj = jointsForEquivalentBodyForces.getSize();
 
         // Generalized forces from ID Solver are in MultibodyTree order and not
         // necessarily in the order of the Coordinates in the Model.
@@ -455,45 +537,16 @@ bool InverseDynamicsTool::run()
 
         Storage genForceResults(nt);
         Storage bodyForcesResults(nt);
-        SpatialVec equivalentBodyForceAtJoint;
 
         for(int i=0; i<nt; i++){
             StateVector
                 genForceVec(times[i], genForceTraj[i]);
             genForceResults.append(genForceVec);
 
-            // if there are joints requested for equivalent body forces then calculate them
+            // if there are joints requested for equivalent body forces
             if(nj>0){
-                Vector forces(6*nj, 0.0);
-                StateVector bodyForcesVec(times[i],
-                                          SimTK::Vector_<double>(6*nj,
-                                                                 &forces[0]));
-
-                s.updTime() = times[i];
-                Vector &q = s.updQ();
-                Vector &u = s.updU();
-
-                // Account for cases where qdot != u with coordinatesToSpeedsIndexMap
-                for( int j = 0; j < nq; ++j) {
-                    q[j] = coordFunctions.evaluate(j, 0, times[i]);
-                }
-                for (int j = 0; j < nu; ++j) {
-                    u[j] = coordFunctions.evaluate(
-                            coordinatesToSpeedsIndexMap[j], 1, times[i]);
-                }
-
-            
-                for(int j=0; j<nj; ++j){
-                    equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForceTraj[i]);
-                    for(int k=0; k<3; ++k){
-                        // body force components
-                        bodyForcesVec.setDataValue(6*j+k, equivalentBodyForceAtJoint[1][k]); 
-                        // body torque components
-                        bodyForcesVec.setDataValue(6*j+k+3, equivalentBodyForceAtJoint[0][k]);
-                    }
-                }
+                StateVector bodyForcesVec(times[i], bodyForcesTraj[i]);
                 bodyForcesResults.append(bodyForcesVec);
-
             }
         }
 
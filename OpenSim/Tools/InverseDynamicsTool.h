@@ -88,6 +88,10 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads used to solve for the forces at the time frames */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +160,16 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /**
+     * get/set the number of threads used to solve for the forces. The time
+     * frames are split into contiguous blocks, each solved on its own thread
+     * with its own copy of the model; the results are the same as with a
+     * single thread. A value less than 1 means to use the number of hardware
+     * threads. The default is 1. If the model has analyses, which must be
+     * stepped through the frames in order, a single thread is used.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------